@@ -1,127 +1,596 @@
 #ifndef BINARY_SEARCH_TREE_H
 #define BINARY_SEARCH_TREE_H
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
-struct TreeNode {
-    int key;
+// Mapped value slot of a node; empty (and optimized away) for plain sets.
+template <typename Value>
+struct TreeNodeValue {
+    Value value;
+    TreeNodeValue() : value() {}
+};
+
+template <>
+struct TreeNodeValue<void> {};
+
+template <typename Key = int, typename Value = void>
+struct TreeNode : TreeNodeValue<Value> {
+    Key key;
     TreeNode* left;
     TreeNode* right;
 
-    TreeNode(int k) : key(k), left(nullptr), right(nullptr) {}
+    TreeNode(const Key& k) : key(k), left(nullptr), right(nullptr) {}
+};
+
+// Three-way comparison used by the tree: <0, 0 or >0 for a < b, a == b, a > b.
+template <typename Key, typename Compare, typename = void>
+struct TreeKeyCompare {
+    template <typename K1, typename K2>
+    static int compare(const Compare& comp, const K1& a, const K2& b) {
+        if (comp(a, b)) return -1;
+        return comp(b, a) ? 1 : 0;
+    }
+};
+
+// Integer keys in natural order compile to two setcc instructions, no branches.
+template <typename Key>
+struct TreeKeyCompare<Key, std::less<Key>, typename std::enable_if<std::is_integral<Key>::value>::type> {
+    static int compare(const std::less<Key>&, Key a, Key b) {
+        return (a > b) - (a < b);
+    }
+};
+
+template <typename Key>
+struct TreeKeyCompare<Key, std::less<>, typename std::enable_if<std::is_integral<Key>::value>::type> {
+    static int compare(const std::less<>&, Key a, Key b) {
+        return (a > b) - (a < b);
+    }
+};
+
+// Worker threads shared by the parallel set operations, started on first
+// use and kept until exit, so a call pays a queue push per fork instead of
+// a thread start. A task no worker has picked up yet is taken back and run
+// by the thread that joins it, so nested forks never wait on a pool busy
+// with their parents.
+class TreeTaskPool {
+public:
+    class Task {
+    private:
+        friend class TreeTaskPool;
+        std::function<void()> body;
+        std::exception_ptr error;
+        bool started = false;
+        bool finished = false;
+
+    public:
+        explicit Task(std::function<void()> b) : body(std::move(b)) {}
+    };
+
+    static TreeTaskPool& shared() {
+        static TreeTaskPool pool;
+        return pool;
+    }
+
+    TreeTaskPool() {}
+    TreeTaskPool(const TreeTaskPool&) = delete;
+    TreeTaskPool& operator=(const TreeTaskPool&) = delete;
+
+    ~TreeTaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    // Starts workers until there are at least count.
+    void reserve(size_t count) {
+        std::lock_guard<std::mutex> lock(guard);
+        while (workers.size() < count) workers.emplace_back(&TreeTaskPool::work, this);
+    }
+
+    void fork(Task& task) {
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            queue.push_back(&task);
+        }
+        wake.notify_one();
+    }
+
+    // Returns once task has run, rethrowing what it threw.
+    void join(Task& task) {
+        std::unique_lock<std::mutex> lock(guard);
+        if (!task.started) {
+            queue.erase(std::find(queue.begin(), queue.end(), &task));
+            task.started = true;
+            lock.unlock();
+            run(task);
+        } else {
+            done.wait(lock, [&task]() { return task.finished; });
+        }
+        if (task.error) std::rethrow_exception(task.error);
+    }
+
+private:
+    std::mutex guard;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::deque<Task*> queue;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    static void run(Task& task) {
+        try {
+            task.body();
+        } catch (...) {
+            task.error = std::current_exception();
+        }
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(guard);
+        for (;;) {
+            wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            Task* task = queue.front();
+            queue.pop_front();
+            task->started = true;
+            lock.unlock();
+            run(*task);
+            lock.lock();
+            task->finished = true;
+            done.notify_all();
+        }
+    }
 };
 
+// Set of Key when Value is void, otherwise a map Key -> Value.
+// A transparent Compare (e.g. std::less<>) enables lookup by any comparable
+// type, such as std::string_view against std::string keys.
+template <typename Key = int, typename Value = void, typename Compare = std::less<Key>>
 class BinarySearchTree {
+public:
+    using Node = TreeNode<Key, Value>;
+
 private:
-    TreeNode* root;
+    using KeyCompare = TreeKeyCompare<Key, Compare>;
+
+    Node* root;
+    Compare comp;
 
-    TreeNode* insertRec(TreeNode* node, int key) {
-        if (node == nullptr) {
-            return new TreeNode(key);
+    template <typename K>
+    Node** findLink(const K& key) {
+        Node** link = &root;
+        while (*link) {
+            int c = KeyCompare::compare(comp, key, (*link)->key);
+            if (c == 0) break;
+            link = c < 0 ? &(*link)->left : &(*link)->right;
         }
+        return link;
+    }
 
-        if (key < node->key) {
-            node->left = insertRec(node->left, key);
-        } else if (key > node->key) {
-            node->right = insertRec(node->right, key);
+    template <typename K>
+    Node* findNode(const K& key) const {
+        Node* node = root;
+        while (node) {
+            int c = KeyCompare::compare(comp, key, node->key);
+            if (c == 0) break;
+            node = c < 0 ? node->left : node->right;
         }
         return node;
     }
 
-    TreeNode* findRec(TreeNode* node, int key) const {
-        if (node == nullptr || node->key == key) {
-            return node;
-        }
+    template <typename K, typename C>
+    using EnableTransparent = typename std::enable_if<
+        !std::is_same<K, Key>::value, std::void_t<typename C::is_transparent>>::type;
 
-        if (key < node->key) {
-            return findRec(node->left, key);
+    // Rotates left children up until none remain, then frees the node and
+    // moves right: no recursion and no auxiliary stack.
+    static void freeSubtree(Node* node) {
+        while (node) {
+            if (node->left) {
+                Node* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                delete node;
+                node = right;
+            }
         }
-        return findRec(node->right, key);
     }
 
-    TreeNode* findMin(TreeNode* node) {
-        TreeNode* current = node;
-        while (current && current->left != nullptr) {
-            current = current->left;
+    // SPLIT / JOIN PRIMITIVES AND SET OPERATIONS
+    // Set operations recurse on the first tree and split the second one by
+    // its root key, O(m log(n/m + 1)) for balanced inputs. Past
+    // SET_OP_MAX_DEPTH levels (a degenerate tree) they fall back to a linear
+    // merge that rebuilds a balanced subtree, so the call stack stays bounded.
+    // The forked halves of the top levels go to TreeTaskPool::shared(), so
+    // a call starts no threads once the pool has enough workers.
+
+    enum class SetOp { Union, Intersection, Difference };
+
+    static const int SET_OP_MAX_DEPTH = 96;
+
+    // Detaches the nodes of t into keys < key and keys > key. Returns the
+    // node equal to key (with null children) or nullptr.
+    Node* splitNodes(Node* t, const Key& key, Node*& less, Node*& greater) const {
+        Node** l = &less;
+        Node** r = &greater;
+        Node* equal = nullptr;
+        while (t) {
+            int c = KeyCompare::compare(comp, key, t->key);
+            if (c < 0) {
+                *r = t;
+                r = &t->left;
+                t = t->left;
+            } else if (c > 0) {
+                *l = t;
+                l = &t->right;
+                t = t->right;
+            } else {
+                *l = t->left;
+                *r = t->right;
+                t->left = t->right = nullptr;
+                equal = t;
+                return equal;
+            }
         }
-        return current;
+        *l = nullptr;
+        *r = nullptr;
+        return equal;
     }
 
-    TreeNode* removeRec(TreeNode* node, int key) {
-        if (node == nullptr) return node;
+    // Joins two trees where every key of less precedes every key of greater,
+    // using the maximum of less as the new root.
+    static Node* joinNodes(Node* less, Node* greater) {
+        if (!less) return greater;
+        if (!greater) return less;
+        Node** link = &less;
+        while ((*link)->right) link = &(*link)->right;
+        Node* pivot = *link;
+        *link = pivot->left;
+        pivot->left = less;
+        pivot->right = greater;
+        return pivot;
+    }
 
-        if (key < node->key) {
-            node->left = removeRec(node->left, key);
-        } else if (key > node->key) {
-            node->right = removeRec(node->right, key);
-        } else {
-            if (node->left == nullptr) {
-                TreeNode* temp = node->right;
-                delete node;
-                return temp;
-            } else if (node->right == nullptr) {
-                TreeNode* temp = node->left;
-                delete node;
-                return temp;
+    static void collectNodes(Node* node, std::vector<Node*>& out) {
+        std::vector<Node*> stack;
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
             }
-            TreeNode* temp = findMin(node->right);
-            node->key = temp->key;
-            node->right = removeRec(node->right, temp->key);
+            node = stack.back();
+            stack.pop_back();
+            out.push_back(node);
+            node = node->right;
         }
+    }
+
+    static Node* buildBalanced(const std::vector<Node*>& nodes, size_t lo, size_t hi) {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        Node* node = nodes[mid];
+        node->left = buildBalanced(nodes, lo, mid);
+        node->right = buildBalanced(nodes, mid + 1, hi);
         return node;
     }
 
-    void printInOrder(TreeNode* node) const {
-        if (node != nullptr) {
-            printInOrder(node->left);
-            std::cout << node->key << " ";
-            printInOrder(node->right);
+    Node* mergeLinear(Node* a, Node* b, SetOp op) const {
+        std::vector<Node*> left, right, result;
+        collectNodes(a, left);
+        collectNodes(b, right);
+        size_t i = 0, j = 0;
+        while (i < left.size() || j < right.size()) {
+            int c = i == left.size() ? 1 : j == right.size() ? -1
+                  : KeyCompare::compare(comp, left[i]->key, right[j]->key);
+            if (c < 0) {
+                if (op != SetOp::Intersection) result.push_back(left[i]);
+                else delete left[i];
+                ++i;
+            } else if (c > 0) {
+                if (op == SetOp::Union) result.push_back(right[j]);
+                else delete right[j];
+                ++j;
+            } else {
+                if (op != SetOp::Difference) result.push_back(left[i]);
+                else delete left[i];
+                delete right[j];
+                ++i;
+                ++j;
+            }
         }
+        return buildBalanced(result, 0, result.size());
     }
 
-    void clearRec(TreeNode* node) {
-        if (node != nullptr) {
-            clearRec(node->left);
-            clearRec(node->right);
-            delete node;
+    Node* setOperation(Node* a, Node* b, SetOp op, int depth, int forkDepth) const {
+        if (!a || !b) {
+            if (op == SetOp::Union) return a ? a : b;
+            freeSubtree(b);
+            if (op == SetOp::Intersection) {
+                freeSubtree(a);
+                return nullptr;
+            }
+            return a;
+        }
+        if (depth >= SET_OP_MAX_DEPTH) {
+            return mergeLinear(a, b, op);
         }
+
+        Node* bLess;
+        Node* bGreater;
+        Node* bEqual = splitNodes(b, a->key, bLess, bGreater);
+        Node* aLess = a->left;
+        Node* aGreater = a->right;
+
+        Node* less;
+        Node* greater;
+        if (depth < forkDepth) {
+            TreeTaskPool& pool = TreeTaskPool::shared();
+            TreeTaskPool::Task task([&]() { less = setOperation(aLess, bLess, op, depth + 1, forkDepth); });
+            pool.fork(task);
+            try {
+                greater = setOperation(aGreater, bGreater, op, depth + 1, forkDepth);
+            } catch (...) {
+                // The task refers to this frame; it has to finish first.
+                try {
+                    pool.join(task);
+                } catch (...) {
+                }
+                throw;
+            }
+            pool.join(task);
+        } else {
+            less = setOperation(aLess, bLess, op, depth + 1, forkDepth);
+            greater = setOperation(aGreater, bGreater, op, depth + 1, forkDepth);
+        }
+
+        bool keep = op == SetOp::Union
+                 || (op == SetOp::Intersection && bEqual)
+                 || (op == SetOp::Difference && !bEqual);
+        delete bEqual;
+        if (!keep) {
+            delete a;
+            return joinNodes(less, greater);
+        }
+        a->left = less;
+        a->right = greater;
+        return a;
+    }
+
+    void applySetOperation(BinarySearchTree& other, SetOp op, unsigned threads) {
+        // A set combined with itself: union and intersection keep it,
+        // difference empties it.
+        if (&other == this) {
+            if (op == SetOp::Difference) clear();
+            return;
+        }
+        int forkDepth = 0;
+        while ((1u << forkDepth) < threads) ++forkDepth;
+        if (forkDepth > 0) TreeTaskPool::shared().reserve((size_t(1) << forkDepth) - 1);
+        Node* otherRoot = other.root;
+        other.root = nullptr;
+        root = setOperation(root, otherRoot, op, 0, forkDepth);
     }
 
 public:
-    BinarySearchTree() : root(nullptr) {}
+    // In-order iterator; the explicit stack holds at most one node per level.
+    class const_iterator {
+    private:
+        std::vector<Node*> stack;
+
+        void pushLeft(Node* node) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        const_iterator() {}
+        explicit const_iterator(Node* root) { pushLeft(root); }
+
+        reference operator*() const { return stack.back()->key; }
+        pointer operator->() const { return &stack.back()->key; }
+
+        template <typename V = Value>
+        const typename std::enable_if<!std::is_void<V>::value, V>::type& value() const {
+            return stack.back()->value;
+        }
+
+        const_iterator& operator++() {
+            Node* node = stack.back();
+            stack.pop_back();
+            pushLeft(node->right);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            if (stack.empty() || other.stack.empty()) return stack.empty() == other.stack.empty();
+            return stack.back() == other.stack.back();
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    BinarySearchTree(const Compare& compare = Compare()) : root(nullptr), comp(compare) {}
 
     ~BinarySearchTree() {
         clear();
     }
 
-    void insert(int key) {
-        root = insertRec(root, key);
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    void insert(const Key& key) {
+        Node** link = findLink(key);
+        if (*link == nullptr) {
+            *link = new Node(key);
+        }
     }
 
-    bool contains(int key) const {
-        return findRec(root, key) != nullptr;
+    // Inserts the key or overwrites the value mapped to it.
+    template <typename V = Value>
+    void insert(const Key& key, const typename std::enable_if<!std::is_void<V>::value, V>::type& value) {
+        Node** link = findLink(key);
+        if (*link == nullptr) {
+            *link = new Node(key);
+        }
+        (*link)->value = value;
     }
 
-    void remove(int key) {
-        root = removeRec(root, key);
+    bool contains(const Key& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    template <typename K, typename C = Compare, typename = EnableTransparent<K, C>>
+    bool contains(const K& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    // Mapped value for the key, or nullptr if the key is absent.
+    template <typename V = Value>
+    typename std::enable_if<!std::is_void<V>::value, V>::type* find(const Key& key) {
+        Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    template <typename V = Value>
+    const typename std::enable_if<!std::is_void<V>::value, V>::type* find(const Key& key) const {
+        Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    template <typename K, typename C = Compare, typename = EnableTransparent<K, C>, typename V = Value>
+    typename std::enable_if<!std::is_void<V>::value, V>::type* find(const K& key) {
+        Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    template <typename K, typename C = Compare, typename = EnableTransparent<K, C>, typename V = Value>
+    const typename std::enable_if<!std::is_void<V>::value, V>::type* find(const K& key) const {
+        Node* node = findNode(key);
+        return node ? &node->value : nullptr;
+    }
+
+    // The in-order successor is relinked into the removed node's place
+    // rather than having its key copied over.
+    void remove(const Key& key) {
+        Node** link = findLink(key);
+        Node* node = *link;
+        if (node == nullptr) return;
+
+        if (node->left == nullptr) {
+            *link = node->right;
+        } else if (node->right == nullptr) {
+            *link = node->left;
+        } else {
+            Node** succLink = &node->right;
+            while ((*succLink)->left) succLink = &(*succLink)->left;
+            Node* succ = *succLink;
+            *succLink = succ->right;
+            succ->left = node->left;
+            succ->right = node->right;
+            *link = succ;
+        }
+        delete node;
     }
 
     void print() const {
-        printInOrder(root);
+        for (const Key& key : *this) {
+            std::cout << key << " ";
+        }
         std::cout << std::endl;
     }
 
     void clear() {
-        clearRec(root);
+        freeSubtree(root);
         root = nullptr;
     }
-    
+
+    // Moves keys below key into less and keys above it into greater, leaving
+    // this tree empty unless it is one of them. Returns whether key itself
+    // was present. The halves are built before the outputs are cleared, so
+    // either output may be *this; if less and greater are the same tree it
+    // gets both halves.
+    bool split(const Key& key, BinarySearchTree& less, BinarySearchTree& greater) {
+        Node* lessRoot = nullptr;
+        Node* greaterRoot = nullptr;
+        Node* equal = splitNodes(root, key, lessRoot, greaterRoot);
+        root = nullptr;
+        less.clear();
+        greater.clear();
+        if (&less == &greater) {
+            less.root = joinNodes(lessRoot, greaterRoot);
+        } else {
+            less.root = lessRoot;
+            greater.root = greaterRoot;
+        }
+        bool found = equal != nullptr;
+        delete equal;
+        return found;
+    }
+
+    // Appends every node of greater, whose keys must all exceed this tree's
+    // keys; greater is left empty.
+    void join(BinarySearchTree& greater) {
+        if (&greater == this) return;
+        root = joinNodes(root, greater.root);
+        greater.root = nullptr;
+    }
+
+    // In-place set operations. They take over the nodes of other, which is
+    // left empty; for equal keys the node (and value) of this tree is kept.
+    // The top log2(threads) levels of the recursion run their halves in
+    // parallel on the shared pool (see TreeTaskPool).
+    void union_with(BinarySearchTree&& other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(other, SetOp::Union, threads);
+    }
+
+    void intersect_with(BinarySearchTree&& other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(other, SetOp::Intersection, threads);
+    }
+
+    void difference(BinarySearchTree&& other, unsigned threads = std::thread::hardware_concurrency()) {
+        applySetOperation(other, SetOp::Difference, threads);
+    }
+
     bool isEmpty() const {
         return root == nullptr;
     }
 
-    TreeNode* getRoot() const { return root; }
-    void setRoot(TreeNode* newRoot) { root = newRoot; }
+    const_iterator begin() const { return const_iterator(root); }
+    const_iterator end() const { return const_iterator(); }
+
+    const Compare& key_comp() const { return comp; }
+
+    Node* getRoot() const { return root; }
+    void setRoot(Node* newRoot) { root = newRoot; }
 };
 
 #endif
@@ -0,0 +1,269 @@
+#ifndef COMPACTLIST_H
+#define COMPACTLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "DynamicArray.h"
+
+// Slot of a CompactDoublyList: the value and 32-bit links to the
+// neighbouring slots. A free slot keeps its successor in the free list in
+// next.
+struct CNode {
+    std::string data;
+    uint32_t next;
+    uint32_t prev;
+};
+
+// Doubly linked list whose nodes live in one DynamicArray and link to each
+// other by slot index. A node is 40 bytes (string + two 4-byte links)
+// instead of an LNode's 48 plus its own heap block, and erased slots are
+// reused through a free list. Nodes pushed in order sit next to each other,
+// so traversal is mostly sequential; after heavy editing compact() moves
+// them back into traversal order.
+//
+// Handles (slot indices from find, iterators) stay valid until their
+// element is erased or compact() runs.
+class CompactDoublyList {
+public:
+    static const uint32_t NIL = 0xFFFFFFFFu;
+
+private:
+    DynamicArray<CNode> slots;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t freeHead;
+    size_t size;
+
+    uint32_t allocate(std::string value) {
+        uint32_t slot;
+        if (freeHead != NIL) {
+            slot = freeHead;
+            freeHead = slots[slot].next;
+            slots[slot].data = std::move(value);
+        } else {
+            slot = static_cast<uint32_t>(slots.get_size());
+            slots.emplace_back(CNode{std::move(value), NIL, NIL});
+        }
+        return slot;
+    }
+
+    void release(uint32_t slot) {
+        slots[slot].data = std::string();
+        slots[slot].prev = NIL;
+        slots[slot].next = freeHead;
+        freeHead = slot;
+    }
+
+    // Links slot in front of pos (NIL: at the end).
+    void linkBefore(uint32_t pos, uint32_t slot) {
+        uint32_t before = pos != NIL ? slots[pos].prev : tail;
+        slots[slot].prev = before;
+        slots[slot].next = pos;
+        if (before != NIL) slots[before].next = slot;
+        else head = slot;
+        if (pos != NIL) slots[pos].prev = slot;
+        else tail = slot;
+        size++;
+    }
+
+    void unlink(uint32_t slot) {
+        uint32_t prev = slots[slot].prev;
+        uint32_t next = slots[slot].next;
+        if (prev != NIL) slots[prev].next = next;
+        else head = next;
+        if (next != NIL) slots[next].prev = prev;
+        else tail = prev;
+        release(slot);
+        size--;
+    }
+
+public:
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class CompactDoublyList;
+        using List = typename std::conditional<Const, const CompactDoublyList, CompactDoublyList>::type;
+        List* list;
+        uint32_t slot;
+
+        Iterator(List* l, uint32_t s) : list(l), slot(s) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const std::string*, std::string*>::type;
+        using reference = typename std::conditional<Const, const std::string&, std::string&>::type;
+
+        Iterator() : list(nullptr), slot(NIL) {}
+
+        operator Iterator<true>() const { return Iterator<true>(list, slot); }
+
+        reference operator*() const { return list->slots[slot].data; }
+        pointer operator->() const { return &list->slots[slot].data; }
+
+        Iterator& operator++() {
+            slot = list->slots[slot].next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // Decrementing end() gives the last element.
+        Iterator& operator--() {
+            slot = slot != NIL ? list->slots[slot].prev : list->tail;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return slot == other.slot; }
+        bool operator!=(const Iterator& other) const { return slot != other.slot; }
+
+        uint32_t get_slot() const { return slot; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    CompactDoublyList() : head(NIL), tail(NIL), freeHead(NIL), size(0) {}
+
+    iterator begin() { return iterator(this, head); }
+    iterator end() { return iterator(this, NIL); }
+    const_iterator begin() const { return const_iterator(this, head); }
+    const_iterator end() const { return const_iterator(this, NIL); }
+
+    void reserve(int capacity) { slots.reserve(capacity); }
+
+    void push_front(const std::string& value) {
+        linkBefore(head, allocate(value));
+    }
+
+    void push_back(const std::string& value) {
+        linkBefore(NIL, allocate(value));
+    }
+
+    void pop_front() {
+        if (head != NIL) unlink(head);
+    }
+
+    void pop_back() {
+        if (tail != NIL) unlink(tail);
+    }
+
+    // Slot of the first element equal to value, or -1.
+    int find(const std::string& value) const {
+        for (uint32_t slot = head; slot != NIL; slot = slots[slot].next) {
+            if (slots[slot].data == value) return static_cast<int>(slot);
+        }
+        return -1;
+    }
+
+    // Value at a slot returned by find(); "" if out of range.
+    std::string get(int slot) const {
+        if (slot < 0 || slot >= slots.get_size()) return "";
+        return slots[slot].data;
+    }
+
+    void remove_value(const std::string& value) {
+        int slot = find(value);
+        if (slot >= 0) unlink(slot);
+    }
+
+    bool insert_after(const std::string& target, const std::string& value) {
+        int slot = find(target);
+        if (slot < 0) return false;
+        linkBefore(slots[slot].next, allocate(value));
+        return true;
+    }
+
+    bool insert_before(const std::string& target, const std::string& value) {
+        int slot = find(target);
+        if (slot < 0) return false;
+        linkBefore(slot, allocate(value));
+        return true;
+    }
+
+    bool delete_after(const std::string& target) {
+        int slot = find(target);
+        if (slot < 0 || slots[slot].next == NIL) return false;
+        unlink(slots[slot].next);
+        return true;
+    }
+
+    bool delete_before(const std::string& target) {
+        int slot = find(target);
+        if (slot < 0 || slots[slot].prev == NIL) return false;
+        unlink(slots[slot].prev);
+        return true;
+    }
+
+    iterator insert(const_iterator pos, std::string value) {
+        uint32_t slot = allocate(std::move(value));
+        linkBefore(pos.slot, slot);
+        return iterator(this, slot);
+    }
+
+    iterator erase(const_iterator pos) {
+        uint32_t next = slots[pos.slot].next;
+        unlink(pos.slot);
+        return iterator(this, next);
+    }
+
+    // Moves the nodes into traversal order, slot i holding the i-th
+    // element, and drops the free slots.
+    void compact() {
+        DynamicArray<CNode> ordered(static_cast<int>(size > 0 ? size : 1));
+        uint32_t index = 0;
+        for (uint32_t slot = head; slot != NIL; slot = slots[slot].next, ++index) {
+            uint32_t next = index + 1 < size ? index + 1 : NIL;
+            ordered.emplace_back(CNode{std::move(slots[slot].data), next, index > 0 ? index - 1 : NIL});
+        }
+        slots = std::move(ordered);
+        head = size > 0 ? 0 : NIL;
+        tail = size > 0 ? static_cast<uint32_t>(size - 1) : NIL;
+        freeHead = NIL;
+    }
+
+    void print() const {
+        for (uint32_t slot = head; slot != NIL; slot = slots[slot].next) {
+            std::cout << slots[slot].data << " <-> ";
+        }
+        std::cout << "NULL" << std::endl;
+    }
+
+    void print_backward() const {
+        for (uint32_t slot = tail; slot != NIL; slot = slots[slot].prev) {
+            std::cout << slots[slot].data << " <-> ";
+        }
+        std::cout << "NULL" << std::endl;
+    }
+
+    // Keeps the slot array for reuse.
+    void clear() {
+        slots.clear();
+        head = tail = freeHead = NIL;
+        size = 0;
+    }
+
+    bool isEmpty() const { return head == NIL; }
+
+    size_t get_size() const { return size; }
+    // Slots in use plus free ones; equals get_size() right after compact().
+    size_t get_slot_count() const { return slots.get_size(); }
+};
+
+#endif
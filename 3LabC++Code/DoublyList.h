@@ -1,15 +1,26 @@
 #ifndef DOUBLYLIST_H
 #define DOUBLYLIST_H
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ListFindMany.h"
+#include "ListIndex.h"
+#include "ListSort.h"
+#include "NodePool.h"
 
 struct LNode {
     std::string data;
     LNode* next;
     LNode* prev;
-    LNode(const std::string& val, LNode* nxt = nullptr, LNode* prv = nullptr) 
-        : data(val), next(nxt), prev(prv) {}
+    LNode(std::string val, LNode* nxt = nullptr, LNode* prv = nullptr)
+        : data(std::move(val)), next(nxt), prev(prv) {}
 };
 
 class DoublyLinkedList {
@@ -17,20 +28,144 @@ private:
     LNode* head;
     LNode* tail;
     size_t size;
+    NodeArena<LNode> nodes;
+    std::unique_ptr<ListIndex<LNode, &LNode::data>> index;
+
+    void unindex(LNode* node) {
+        if (index) index->removed(node, head);
+    }
+
+    // Links the detached chain first..last in front of pos (nullptr: at
+    // the end).
+    void linkBefore(LNode* pos, LNode* first, LNode* last) {
+        LNode* before = pos ? pos->prev : tail;
+        first->prev = before;
+        last->next = pos;
+        if (before) before->next = first;
+        else head = first;
+        if (pos) pos->prev = last;
+        else tail = last;
+    }
+
+    // Unlinks the chain first..last without destroying it.
+    void detach(LNode* first, LNode* last) {
+        if (first->prev) first->prev->next = last->next;
+        else head = last->next;
+        if (last->next) last->next->prev = first->prev;
+        else tail = first->prev;
+        first->prev = last->next = nullptr;
+    }
+
+    void reindex() {
+        if (!index) return;
+        index->clear();
+        for (LNode* node = head; node; node = node->next) index->added(node, ListPosition::Back);
+    }
+
+    // Restores prev links and tail after the chain was relinked by next.
+    void relinkPrev() {
+        LNode* prev = nullptr;
+        for (LNode* node = head; node; node = node->next) {
+            node->prev = prev;
+            prev = node;
+        }
+        tail = prev;
+    }
+
+    ListPosition positionOf(LNode* node) const {
+        if (node == head) return ListPosition::Front;
+        return node == tail ? ListPosition::Back : ListPosition::Middle;
+    }
 
 public:
-    DoublyLinkedList() : head(nullptr), tail(nullptr), size(0) {}
+    // Bidirectional iterator over the values. It stays valid until its own
+    // element is erased, and follows the element through moves within the
+    // list and through splices that relink its node, so it can serve as a
+    // handle (e.g. in an LRU map). Splices between pooled lists that move
+    // the values into new nodes (see splice) invalidate iterators to the
+    // moved elements.
+    template <bool Const>
+    class Iterator {
+    private:
+        friend class DoublyLinkedList;
+        LNode* node;
+        // Past the end: the list whose tail -- returns, unless the iterator
+        // got there by ++ from last. The tail is then found by following
+        // last's next links, since a splice may have moved last to another
+        // list; last has to remain in a list until then.
+        const DoublyLinkedList* list;
+        LNode* last;
+
+        Iterator(LNode* n, const DoublyLinkedList* l, LNode* lst = nullptr) : node(n), list(l), last(lst) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const std::string*, std::string*>::type;
+        using reference = typename std::conditional<Const, const std::string&, std::string&>::type;
+
+        Iterator() : node(nullptr), list(nullptr), last(nullptr) {}
+
+        operator Iterator<true>() const { return Iterator<true>(node, list, last); }
+
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &node->data; }
+
+        Iterator& operator++() {
+            last = node;
+            node = node->next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // Decrementing end() gives the last element.
+        Iterator& operator--() {
+            if (node) {
+                node = node->prev;
+            } else if (last) {
+                while (last->next) last = last->next;
+                node = last;
+            } else {
+                node = list->tail;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+        LNode* get_node() const { return node; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit DoublyLinkedList(const NodeAllocator& alloc = NodeAllocator())
+        : head(nullptr), tail(nullptr), size(0), nodes(alloc) {}
 
     ~DoublyLinkedList() {
         clear();
     }
 
     void push_front(const std::string& value) {
-        LNode* newNode = new LNode(value, head, nullptr);
+        LNode* newNode = nodes.create(value, head, nullptr);
         if (head) head->prev = newNode;
         head = newNode;
         if (!tail) tail = head;
         size++;
+        if (index) index->added(newNode, ListPosition::Front);
     }
 
     void push_back(const std::string& value) {
@@ -38,51 +173,231 @@ public:
             push_front(value);
             return;
         }
-        LNode* newNode = new LNode(value, nullptr, tail);
+        LNode* newNode = nodes.create(value, nullptr, tail);
         tail->next = newNode;
         tail = newNode;
         size++;
+        if (index) index->added(newNode, ListPosition::Back);
     }
 
     void pop_front() {
         if (!head) return;
         LNode* temp = head;
+        unindex(temp);
         head = head->next;
         if (head) head->prev = nullptr;
         else tail = nullptr;
-        delete temp;
+        nodes.destroy(temp);
         size--;
     }
 
     void pop_back() {
         if (!tail) return;
         LNode* temp = tail;
+        unindex(temp);
         tail = tail->prev;
         if (tail) tail->next = nullptr;
         else head = nullptr;
-        delete temp;
+        nodes.destroy(temp);
         size--;
     }
 
     void remove_value(const std::string& value) {
-        LNode* current = head;
-        while (current) {
-            if (current->data == value) {
-                if (current->prev) current->prev->next = current->next;
-                else head = current->next;
-                
-                if (current->next) current->next->prev = current->prev;
-                else tail = current->prev;
-
-                delete current;
-                size--;
-                return;
+        LNode* current = find(value);
+        if (!current) return;
+        unindex(current);
+        if (current->prev) current->prev->next = current->next;
+        else head = current->next;
+
+        if (current->next) current->next->prev = current->prev;
+        else tail = current->prev;
+
+        nodes.destroy(current);
+        size--;
+    }
+
+    iterator begin() { return iterator(head, this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(head, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Iterator for a node of this list, e.g. one returned by find().
+    iterator iterator_to(LNode* node) { return iterator(node, this); }
+
+    // Inserts value before pos and returns an iterator to it.
+    iterator insert(const_iterator pos, std::string value) {
+        LNode* node = nodes.create(std::move(value));
+        linkBefore(pos.node, node, node);
+        size++;
+        if (index) index->added(node, positionOf(node));
+        return iterator(node, this);
+    }
+
+    // Erases the element at pos and returns the iterator after it.
+    iterator erase(const_iterator pos) {
+        LNode* node = pos.node;
+        LNode* next = node->next;
+        unindex(node);
+        detach(node, node);
+        nodes.destroy(node);
+        size--;
+        return iterator(next, this);
+    }
+
+    void move_to_front(const_iterator pos) {
+        LNode* node = pos.node;
+        if (node == head) return;
+        detach(node, node);
+        linkBefore(head, node, node);
+        if (index) index->relinked(node, ListPosition::Front);
+    }
+
+    void move_to_back(const_iterator pos) {
+        LNode* node = pos.node;
+        if (node == tail) return;
+        detach(node, node);
+        linkBefore(nullptr, node, node);
+        if (index) index->relinked(node, ListPosition::Back);
+    }
+
+    // Moves [first, last) of other in front of pos; pos must not lie in the
+    // range. Within one list, or between lists whose nodes come from new /
+    // delete, the nodes are relinked: O(1) within a list, O(range) across
+    // lists for the size count. Pooled nodes cannot leave their slabs, so
+    // between pooled lists the values are moved into new nodes, except
+    // that a whole pooled list is relinked if the slabs can be adopted.
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator first, const_iterator last) {
+        if (first == last) return;
+        LNode* from = first.node;
+        LNode* to = last.node ? last.node->prev : other.tail;
+        if (&other == this) {
+            // Every end() holds a null node, so these compare nodes only
+            // within one list.
+            if (pos == first || pos == last) return;
+            detach(from, to);
+            linkBefore(pos.node, from, to);
+            for (LNode* node = from; index; node = node->next) {
+                index->relinked(node, ListPosition::Middle);
+                if (node == to) break;
             }
-            current = current->next;
+            return;
+        }
+        bool whole = from == other.head && !last.node;
+        bool relink = nodes.canAdopt(other.nodes) && (whole || !nodes.get_allocator().pooled);
+        if (!relink) {
+            while (first != last) {
+                LNode* node = first.node;
+                ++first;
+                other.unindex(node);
+                insert(pos, std::move(node->data));
+                other.detach(node, node);
+                other.nodes.destroy(node);
+                other.size--;
+            }
+            return;
         }
+        // Detached first, so other's index never repoints at a node of
+        // the range while reporting its removal.
+        other.detach(from, to);
+        size_t count = 0;
+        for (LNode* node = from; node; node = node->next) {
+            other.unindex(node);
+            count++;
+        }
+        if (whole) nodes.adopt(other.nodes);
+        other.size -= count;
+        linkBefore(pos.node, from, to);
+        size += count;
+        for (LNode* node = from; index; node = node->next) {
+            index->added(node, ListPosition::Middle);
+            if (node == to) break;
+        }
+    }
+
+    void splice(const_iterator pos, DoublyLinkedList& other) {
+        splice(pos, other, other.begin(), other.end());
+    }
+
+    void splice(const_iterator pos, DoublyLinkedList& other, const_iterator it) {
+        const_iterator next = it;
+        splice(pos, other, it, ++next);
+    }
+
+    // Stable O(n log n) bottom-up merge sort; relinks the nodes, the
+    // strings stay where they are. Iterators stay valid.
+    void sort() {
+        head = sortChain<LNode, &LNode::data>(head);
+        relinkPrev();
+        reindex();
+    }
+
+    // Removes consecutive equal values (every duplicate, once sorted) and
+    // returns the new size.
+    size_t unique() {
+        for (LNode* node = head; node && node->next;) {
+            if (node->next->data == node->data) erase(const_iterator(node->next, this));
+            else node = node->next;
+        }
+        return size;
+    }
+
+    // Merges the sorted list other into this sorted list in one pass,
+    // leaving other empty. Equal values keep this list's first. other's
+    // nodes are relinked when the storage allows it (see splice), else
+    // their values are moved into new nodes first.
+    void merge(DoublyLinkedList& other) {
+        if (this == &other || !other.head) return;
+        if (!nodes.canAdopt(other.nodes)) {
+            DoublyLinkedList moved(nodes.get_allocator());
+            for (LNode* node = other.head; node; node = node->next) {
+                LNode* created = moved.nodes.create(std::move(node->data));
+                moved.linkBefore(nullptr, created, created);
+                moved.size++;
+            }
+            other.clear();
+            merge(moved);
+            return;
+        }
+        nodes.adopt(other.nodes);
+        if (other.index) other.index->clear();
+        head = mergeChains<LNode, &LNode::data>(head, other.head);
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+        relinkPrev();
+        reindex();
+    }
+
+    // Removes every value for which pred(value) is true in one pass and
+    // returns how many were removed.
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        // The index is rebuilt once instead of being updated per node.
+        if (index) index->clear();
+        size_t removed = 0;
+        try {
+            for (LNode* node = head; node;) {
+                LNode* next = node->next;
+                if (pred(node->data)) {
+                    detach(node, node);
+                    nodes.destroy(node);
+                    size--;
+                    removed++;
+                }
+                node = next;
+            }
+        } catch (...) {
+            reindex();
+            throw;
+        }
+        reindex();
+        return removed;
     }
 
     LNode* find(const std::string& value) const {
+        if (index) return index->first(value, head);
         LNode* temp = head;
         while (temp) {
             if (temp->data == value) {
@@ -93,11 +408,29 @@ public:
         return nullptr;
     }
 
+    // find() for many values in one traversal: result[i] is the first node
+    // equal to values[i], or nullptr. Costs one walk of the list (up to the
+    // last first match) instead of one per value; with the index each
+    // value is an O(1) lookup instead.
+    std::vector<LNode*> find_many(const std::string_view* values, size_t count) const {
+        std::vector<LNode*> result(count, nullptr);
+        if (index) {
+            for (size_t i = 0; i < count; ++i) result[i] = index->first(values[i], head);
+        } else {
+            findManyInChain<LNode, &LNode::data>(head, values, count, result.data());
+        }
+        return result;
+    }
+
+    std::vector<LNode*> find_many(const std::vector<std::string_view>& values) const {
+        return find_many(values.data(), values.size());
+    }
+
     bool insert_after(const std::string& target, const std::string& value) {
         LNode* targetNode = find(target);
         if (!targetNode) return false;
 
-        LNode* newNode = new LNode(value, targetNode->next, targetNode);
+        LNode* newNode = nodes.create(value, targetNode->next, targetNode);
         
         if (targetNode->next) {
             targetNode->next->prev = newNode;
@@ -106,6 +439,7 @@ public:
         }
         targetNode->next = newNode;
         size++;
+        if (index) index->added(newNode, newNode == tail ? ListPosition::Back : ListPosition::Middle);
         return true;
     }
 
@@ -118,10 +452,11 @@ public:
             return true;
         }
 
-        LNode* newNode = new LNode(value, targetNode, targetNode->prev);
+        LNode* newNode = nodes.create(value, targetNode, targetNode->prev);
         targetNode->prev->next = newNode;
         targetNode->prev = newNode;
         size++;
+        if (index) index->added(newNode, ListPosition::Middle);
         return true;
     }
 
@@ -130,6 +465,7 @@ public:
         if (!targetNode || !targetNode->next) return false;
 
         LNode* nodeToDelete = targetNode->next;
+        unindex(nodeToDelete);
         targetNode->next = nodeToDelete->next;
 
         if (nodeToDelete->next) {
@@ -137,7 +473,7 @@ public:
         } else {
             tail = targetNode;
         }
-        delete nodeToDelete;
+        nodes.destroy(nodeToDelete);
         size--;
         return true;
     }
@@ -147,6 +483,7 @@ public:
         if (!targetNode || !targetNode->prev) return false;
 
         LNode* nodeToDelete = targetNode->prev;
+        unindex(nodeToDelete);
         targetNode->prev = nodeToDelete->prev;
 
         if (nodeToDelete->prev) {
@@ -154,7 +491,7 @@ public:
         } else {
             head = targetNode;
         }
-        delete nodeToDelete;
+        nodes.destroy(nodeToDelete);
         size--;
         return true;
     }
@@ -178,9 +515,30 @@ public:
     }
 
     void clear() {
-        while (head) pop_front();
+        if (index) index->clear();
+        while (head) {
+            LNode* next = head->next;
+            nodes.dispose(head);
+            head = next;
+        }
+        nodes.release();
+        tail = nullptr;
+        size = 0;
     }
 
+    // Keeps a value -> first node hash index from now on, making find and
+    // every target-based edit O(1) expected. Costs about index_memory()
+    // bytes; values must not be changed through node pointers meanwhile.
+    void enable_index() {
+        if (index) return;
+        index.reset(new ListIndex<LNode, &LNode::data>());
+        for (LNode* node = head; node; node = node->next) index->added(node, ListPosition::Back);
+    }
+
+    void disable_index() { index.reset(); }
+    bool has_index() const { return index != nullptr; }
+    size_t index_memory() const { return index ? index->memory_usage() : 0; }
+
     bool isEmpty() const { return head == nullptr; }
 
     LNode* getHead() const { return head; }
@@ -1,72 +1,417 @@
 #ifndef DYNAMICARRAY_H
 #define DYNAMICARRAY_H
 
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <iostream>
+#include <new>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "MemoryPolicy.h"
+#include "SimdScan.h"
 
-class DynamicArray {
+// Types whose objects may be moved to another address with memcpy.
+// Specialize for types that are not trivially copyable but still safe to
+// relocate bytewise (e.g. types holding only owning pointers).
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Inline element buffer of DynamicArray<T, N>; empty when N == 0.
+template <typename T, int N>
+struct DynamicArrayInlineBuffer {
+    alignas(T) unsigned char bytes[sizeof(T) * N];
+    T* inlineData() { return reinterpret_cast<T*>(bytes); }
+};
+
+template <typename T>
+struct DynamicArrayInlineBuffer<T, 0> {
+    T* inlineData() { return nullptr; }
+};
+
+// With N > 0 the first N elements live inside the object itself and the
+// heap is only touched once the array grows past them (a small vector).
+// Allocator supplies the heap buffers; PolicyArrayAllocator places large
+// ones on huge pages and/or across NUMA nodes (see MemoryPolicy.h).
+template <typename T = std::string, int N = 0, typename Allocator = HeapArrayAllocator>
+class DynamicArray : private DynamicArrayInlineBuffer<T, N>, private Allocator {
 private:
-    std::string* data;
+    T* data;
     int size;
     int capacity;
 
-    void resize() {
-        int new_capacity = capacity * 2;
-        std::string* new_data = new std::string[new_capacity];
-        for (int i = 0; i < size; ++i) {
-            new_data[i] = data[i];
-        }
-        delete[] data;
+    const Allocator& allocator() const { return *this; }
+
+    T* allocate(int n) const {
+        return static_cast<T*>(allocator().allocate(sizeof(T) * n));
+    }
+
+    bool isInline() const {
+        return N > 0 && data == const_cast<DynamicArray*>(this)->inlineData();
+    }
+
+    void releaseStorage() {
+        if (!isInline()) allocator().deallocate(data, sizeof(T) * capacity);
+    }
+
+    // Switches to storage with room for new_capacity elements; the caller
+    // has already moved the elements into new_data.
+    void adopt(T* new_data, int new_capacity) {
+        releaseStorage();
         data = new_data;
         capacity = new_capacity;
     }
 
+    int nextCapacity() const {
+        return capacity > 0 ? capacity * 2 : 4;
+    }
+
+    // Moves count elements into uninitialized storage at dest and ends the
+    // lifetime of the sources.
+    static void relocate(T* src, int count, T* dest) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            if (count > 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(T) * count);
+        } else {
+            for (int i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    static void destroy(T* first, int count) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (int i = 0; i < count; ++i) first[i].~T();
+        }
+    }
+
+    void reallocate(int new_capacity) {
+        T* new_data = allocate(new_capacity);
+        relocate(data, size, new_data);
+        adopt(new_data, new_capacity);
+    }
+
+    // Below this many elements per thread a sort runs serially.
+    static const int PARALLEL_SORT_MIN = 1 << 14;
+    // Strings sharing a longer prefix than this finish with a comparison sort.
+    static const size_t RADIX_MAX_DEPTH = 64;
+    static const int RADIX_CUTOFF = 32;
+
+    // Byte of s at depth, shifted by one so that 0 marks "string ended".
+    static int radixBucket(const std::string& s, size_t depth) {
+        return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1 : 0;
+    }
+
+    // In-place MSD radix sort (American flag sort) of strings that all
+    // share their first depth bytes.
+    static void radixSort(std::string* first, int n, size_t depth) {
+        if (n < RADIX_CUTOFF || depth >= RADIX_MAX_DEPTH) {
+            std::sort(first, first + n, [depth](const std::string& a, const std::string& b) {
+                return a.compare(depth, std::string::npos, b, depth, std::string::npos) < 0;
+            });
+            return;
+        }
+        int count[257] = {};
+        for (int i = 0; i < n; ++i) count[radixBucket(first[i], depth)]++;
+        int start[258];
+        int next[257];
+        start[0] = 0;
+        for (int b = 0; b < 257; ++b) {
+            start[b + 1] = start[b] + count[b];
+            next[b] = start[b];
+        }
+        for (int b = 0; b < 257; ++b) {
+            while (next[b] < start[b + 1]) {
+                int c = radixBucket(first[next[b]], depth);
+                if (c == b) next[b]++;
+                else std::swap(first[next[b]], first[next[c]++]);
+            }
+        }
+        // Bucket 0 holds strings that ended here; they are all equal.
+        for (int b = 1; b < 257; ++b) {
+            if (count[b] > 1) radixSort(first + start[b], count[b], depth + 1);
+        }
+    }
+
+    static void serialSort(T* first, int n) {
+        if constexpr (std::is_same<T, std::string>::value) {
+            radixSort(first, n, 0);
+        } else {
+            std::sort(first, first + n);
+        }
+    }
+
+    // Sorts both halves concurrently, then merges them.
+    static void parallelSort(T* first, int n, unsigned threads) {
+        if (threads <= 1 || n < 2 * PARALLEL_SORT_MIN) {
+            serialSort(first, n);
+            return;
+        }
+        int half = n / 2;
+        std::future<void> left = std::async(std::launch::async, [=]() {
+            parallelSort(first, half, threads / 2);
+        });
+        parallelSort(first + half, n - half, threads - threads / 2);
+        left.get();
+        std::inplace_merge(first, first + half, first + n);
+    }
+
+    // Takes over other's elements, leaving other empty on its own storage.
+    void stealFrom(DynamicArray& other) noexcept {
+        if (other.isInline()) {
+            data = this->inlineData();
+            capacity = N;
+            relocate(other.data, other.size, data);
+        } else {
+            data = other.data;
+            capacity = other.capacity;
+            other.data = other.inlineData();
+            other.capacity = N;
+        }
+        size = other.size;
+        other.size = 0;
+    }
+
+    // Opens a hole at index, constructs the element there from args.
+    template <typename... Args>
+    void emplaceAt(int index, Args&&... args) {
+        if (size >= capacity) {
+            int new_capacity = nextCapacity();
+            T* new_data = allocate(new_capacity);
+            ::new (static_cast<void*>(new_data + index)) T(std::forward<Args>(args)...);
+            relocate(data, index, new_data);
+            relocate(data + index, size - index, new_data + index + 1);
+            adopt(new_data, new_capacity);
+        } else if (index == size) {
+            ::new (static_cast<void*>(data + size)) T(std::forward<Args>(args)...);
+        } else {
+            T value(std::forward<Args>(args)...);
+            if constexpr (is_trivially_relocatable<T>::value) {
+                std::memmove(static_cast<void*>(data + index + 1), static_cast<const void*>(data + index),
+                             sizeof(T) * (size - index));
+                ::new (static_cast<void*>(data + index)) T(std::move(value));
+            } else {
+                ::new (static_cast<void*>(data + size)) T(std::move(data[size - 1]));
+                std::move_backward(data + index, data + size - 1, data + size);
+                data[index] = std::move(value);
+            }
+        }
+        size++;
+    }
+
 public:
-    DynamicArray(int initial_capacity = 4) : size(0), capacity(initial_capacity) {
-        if (capacity <= 0) capacity = 4;
-        data = new std::string[capacity];
+    // The default starting capacity is the inline one when there is one,
+    // so a small array does not allocate until it outgrows N.
+    DynamicArray(int initial_capacity = N > 0 ? N : 4, const Allocator& alloc = Allocator())
+        : Allocator(alloc), size(0), capacity(initial_capacity) {
+        if (capacity <= 0) capacity = N > 0 ? N : 4;
+        if (capacity <= N) {
+            data = this->inlineData();
+            capacity = N;
+        } else {
+            data = allocate(capacity);
+        }
+    }
+
+    DynamicArray(const DynamicArray& other) : DynamicArray(other.size, other.allocator()) {
+        for (; size < other.size; ++size) {
+            ::new (static_cast<void*>(data + size)) T(other.data[size]);
+        }
+    }
+
+    DynamicArray(DynamicArray&& other) noexcept : Allocator(other.allocator()) {
+        stealFrom(other);
+    }
+
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size);
+            for (; size < other.size; ++size) {
+                ::new (static_cast<void*>(data + size)) T(other.data[size]);
+            }
+        }
+        return *this;
+    }
+
+    DynamicArray& operator=(DynamicArray&& other) noexcept {
+        if (this != &other) {
+            destroy(data, size);
+            releaseStorage();
+            static_cast<Allocator&>(*this) = other.allocator();
+            stealFrom(other);
+        }
+        return *this;
     }
 
     ~DynamicArray() {
-        delete[] data;
+        destroy(data, size);
+        releaseStorage();
+    }
+
+    void reserve(int new_capacity) {
+        if (new_capacity > capacity) reallocate(new_capacity);
     }
 
-    void push_back(const std::string& value) {
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
         if (size >= capacity) {
-            resize();
+            // Construct first: args may refer to an element of this array.
+            int new_capacity = nextCapacity();
+            T* new_data = allocate(new_capacity);
+            ::new (static_cast<void*>(new_data + size)) T(std::forward<Args>(args)...);
+            relocate(data, size, new_data);
+            adopt(new_data, new_capacity);
+        } else {
+            ::new (static_cast<void*>(data + size)) T(std::forward<Args>(args)...);
         }
-        data[size++] = value;
+        return data[size++];
     }
 
-    void insert(int index, const std::string& value) {
+    void insert(int index, const T& value) {
         if (index < 0 || index > size) return;
-        if (size >= capacity) resize();
-        
-        for (int i = size; i > index; --i) {
-            data[i] = data[i - 1];
-        }
-        data[index] = value;
-        size++;
+        emplaceAt(index, value);
+    }
+
+    void insert(int index, T&& value) {
+        if (index < 0 || index > size) return;
+        emplaceAt(index, std::move(value));
     }
 
-    std::string get(int index) const {
-        if (index < 0 || index >= size) return "";
+    T get(int index) const {
+        if (index < 0 || index >= size) return T();
         return data[index];
     }
 
+    // Unchecked access without the copy made by get().
+    T& operator[](int index) { return data[index]; }
+    const T& operator[](int index) const { return data[index]; }
+
     void remove_at(int index) {
         if (index < 0 || index >= size) return;
-        for (int i = index; i < size - 1; ++i) {
-            data[i] = data[i + 1];
+        if constexpr (is_trivially_relocatable<T>::value) {
+            data[index].~T();
+            std::memmove(static_cast<void*>(data + index), static_cast<const void*>(data + index + 1),
+                         sizeof(T) * (size - index - 1));
+        } else {
+            std::move(data + index + 1, data + size, data + index);
+            data[size - 1].~T();
         }
         size--;
     }
 
-    void set(int index, const std::string& value) {
+    void set(int index, const T& value) {
         if (index < 0 || index >= size) return;
         data[index] = value;
     }
 
+    void set(int index, T&& value) {
+        if (index < 0 || index >= size) return;
+        data[index] = std::move(value);
+    }
+
+    // Sorts ascending in place. Strings use an MSD radix sort; with several
+    // threads the halves are sorted concurrently and merged.
+    void sort(unsigned threads = std::thread::hardware_concurrency()) {
+        parallelSort(data, size, threads);
+    }
+
+    // Drops consecutive duplicates (all duplicates once sorted); returns the
+    // new size.
+    int unique() {
+        if (size == 0) return 0;
+        int kept = 1;
+        for (int i = 1; i < size; ++i) {
+            if (data[i] == data[kept - 1]) continue;
+            if (i != kept) data[kept] = std::move(data[i]);
+            kept++;
+        }
+        destroy(data + kept, size - kept);
+        size = kept;
+        return size;
+    }
+
+    // Index of the first element not less than value in a sorted array;
+    // get_size() if there is none.
+    int lower_bound(const T& value) const {
+        return static_cast<int>(std::lower_bound(data, data + size, value) - data);
+    }
+
+    // Index of the first element equal to value at or after from, or -1.
+    // Integer elements are scanned with SIMD compares; strings compare
+    // lengths before bytes.
+    int find(const T& value, int from = 0) const {
+        if (from < 0) from = 0;
+        if (from >= size) return -1;
+        if constexpr (std::is_same<T, std::string>::value) {
+            for (int i = from; i < size; ++i) {
+                if (simdStringEqual(data[i], value)) return i;
+            }
+            return -1;
+        } else {
+            int found = simdFind(data + from, size - from, value);
+            return found < 0 ? -1 : from + found;
+        }
+    }
+
+    int count(const T& value) const {
+        if constexpr (std::is_same<T, std::string>::value) {
+            int found = 0;
+            for (int i = 0; i < size; ++i) found += simdStringEqual(data[i], value);
+            return found;
+        } else {
+            return simdCount(data, size, value);
+        }
+    }
+
+    // True if any element equals any element of values.
+    template <int M, typename A>
+    bool contains_any(const DynamicArray<T, M, A>& values) const {
+        int k = values.get_size();
+        if (k == 0) return false;
+        if constexpr (std::is_same<T, std::string>::value) {
+            unsigned long long lengths = lengthFilter(values, k);
+            for (int i = 0; i < size; ++i) {
+                if (!(lengths >> (data[i].size() & 63) & 1)) continue;
+                for (int j = 0; j < k; ++j) {
+                    if (simdStringEqual(data[i], values[j])) return true;
+                }
+            }
+            return false;
+        } else {
+            return simdContainsAny(data, size, &values[0], k);
+        }
+    }
+
+    // Index of the first string starting with prefix at or after from, or -1.
+    template <typename U = T>
+    typename std::enable_if<std::is_same<U, std::string>::value, int>::type
+    find_prefix(std::string_view prefix, int from = 0) const {
+        for (int i = from < 0 ? 0 : from; i < size; ++i) {
+            if (simdStartsWith(data[i], prefix)) return i;
+        }
+        return -1;
+    }
+
+    template <typename U = T>
+    typename std::enable_if<std::is_same<U, std::string>::value, int>::type
+    count_prefix(std::string_view prefix) const {
+        int found = 0;
+        for (int i = 0; i < size; ++i) found += simdStartsWith(data[i], prefix);
+        return found;
+    }
+
     void print() const {
         for (int i = 0; i < size; ++i) {
             std::cout << data[i] << " ";
@@ -74,15 +419,14 @@ public:
         std::cout << std::endl;
     }
 
+    // Destroys the elements but keeps the allocated storage.
     void clear() {
-        delete[] data;
+        destroy(data, size);
         size = 0;
-        capacity = 4;
-        data = new std::string[capacity];
     }
-    
+
     int get_size() const { return size; }
     int get_capacity() const { return capacity; }
 };
 
-#endif
\ No newline at end of file
+#endif
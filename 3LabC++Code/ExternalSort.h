@@ -0,0 +1,282 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "DynamicArray.h"
+#include "Serialization.h"
+
+// Sorting of string sets larger than memory. Strings are collected into an
+// in-memory run until the budget is used up; each full run is sorted with
+// DynamicArray::sort and spilled with saveToBinary, so run files use the
+// binary format of Serialization.h (int count, then int length + bytes per
+// string). The runs are then merged through a loser tree, reading every
+// run and writing the output through large sequential buffers.
+
+struct ExternalSortOptions {
+    // Approximate bytes of strings held in memory before a run is spilled.
+    size_t memoryBudget = size_t(256) << 20;
+    std::string tempDirectory = ".";
+    unsigned threads = std::thread::hardware_concurrency();
+    // Buffer per open run file and for the output during the merge.
+    size_t ioBufferSize = size_t(1) << 20;
+    // Most runs merged at once; more runs are first merged in groups of
+    // this size into longer runs, keeping open files and buffers bounded.
+    int maxMergeWidth = 128;
+};
+
+// Sequential reader of one file in the binary string format.
+class BinaryStringReader {
+private:
+    std::unique_ptr<char[]> buffer;
+    std::ifstream file;
+    std::string path;
+    int remaining;
+    std::string current;
+
+public:
+    BinaryStringReader(const std::string& filename, size_t bufferSize)
+        : buffer(new char[bufferSize]), path(filename), remaining(0) {
+        file.rdbuf()->pubsetbuf(buffer.get(), static_cast<std::streamsize>(bufferSize));
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+        if (!file.read(reinterpret_cast<char*>(&remaining), sizeof(remaining)) || remaining < 0) {
+            throw std::runtime_error("Corrupt string file: " + filename);
+        }
+    }
+
+    // Loads the next string into value(); false once the file is exhausted.
+    bool next() {
+        if (remaining == 0) return false;
+        int len;
+        if (!file.read(reinterpret_cast<char*>(&len), sizeof(len)) || len < 0) {
+            throw std::runtime_error("Corrupt string file: " + path);
+        }
+        current.resize(len);
+        if (len > 0 && !file.read(&current[0], len)) throw std::runtime_error("Corrupt string file: " + path);
+        remaining--;
+        return true;
+    }
+
+    const std::string& value() const { return current; }
+    std::string& value() { return current; }
+    int get_remaining() const { return remaining; }
+};
+
+// Sequential writer of one file in the binary string format; the element
+// count goes first, so it must be known up front.
+class BinaryStringWriter {
+private:
+    std::unique_ptr<char[]> buffer;
+    std::ofstream file;
+    std::string path;
+
+public:
+    BinaryStringWriter(const std::string& filename, int count, size_t bufferSize)
+        : buffer(new char[bufferSize]), path(filename) {
+        file.rdbuf()->pubsetbuf(buffer.get(), static_cast<std::streamsize>(bufferSize));
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    void write(const std::string& str) {
+        int len = static_cast<int>(str.size());
+        file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        file.write(str.data(), len);
+    }
+
+    void close() {
+        file.close();
+        if (!file) throw std::runtime_error("Cannot write file: " + path);
+    }
+};
+
+// Tournament tree over k sorted inputs that keeps the loser of every match
+// in the inner nodes, so replacing the winner costs one root-to-leaf walk
+// of log2(k) comparisons against the stored losers only.
+class LoserTree {
+private:
+    std::vector<BinaryStringReader*> inputs;
+    std::vector<bool> exhausted;
+    std::vector<int> losers;  // losers[0] holds the overall winner
+    int k;
+
+    // Exhausted inputs lose every match; ties go to the lower index.
+    bool beats(int a, int b) const {
+        if (exhausted[a]) return false;
+        if (exhausted[b]) return true;
+        int c = inputs[a]->value().compare(inputs[b]->value());
+        return c < 0 || (c == 0 && a < b);
+    }
+
+public:
+    explicit LoserTree(const std::vector<BinaryStringReader*>& readers)
+        : inputs(readers), exhausted(readers.size()), losers(readers.size() > 0 ? readers.size() : 1), k(static_cast<int>(readers.size())) {
+        if (k == 0) return;
+        for (int i = 0; i < k; ++i) exhausted[i] = !inputs[i]->next();
+        std::vector<int> winners(2 * k);
+        for (int i = 0; i < k; ++i) winners[k + i] = i;
+        for (int n = k - 1; n >= 1; --n) {
+            int a = winners[2 * n];
+            int b = winners[2 * n + 1];
+            bool aWins = beats(a, b);
+            winners[n] = aWins ? a : b;
+            losers[n] = aWins ? b : a;
+        }
+        losers[0] = winners[1];
+    }
+
+    bool isEmpty() const { return k == 0 || exhausted[losers[0]]; }
+
+    // Current smallest string; valid until pop().
+    std::string& top() { return inputs[losers[0]]->value(); }
+
+    void pop() {
+        int winner = losers[0];
+        exhausted[winner] = !inputs[winner]->next();
+        for (int n = (winner + k) / 2; n >= 1; n /= 2) {
+            if (beats(losers[n], winner)) std::swap(losers[n], winner);
+        }
+        losers[0] = winner;
+    }
+};
+
+class ExternalSorter {
+private:
+    ExternalSortOptions options;
+    DynamicArray<std::string> run;
+    size_t runBytes;
+    std::vector<std::string> runFiles;
+    long long total;
+    std::string prefix;
+    int nextRun;
+
+    std::string newRunPath() {
+        return prefix + std::to_string(nextRun++) + ".bin";
+    }
+
+    void spill() {
+        if (run.get_size() == 0) return;
+        run.sort(options.threads);
+        std::string path = newRunPath();
+        runFiles.push_back(path);
+        saveToBinary(run, path);
+        run.clear();
+        runBytes = 0;
+    }
+
+    template <typename Consumer>
+    void mergeFiles(const std::vector<std::string>& paths, Consumer consume) {
+        std::vector<std::unique_ptr<BinaryStringReader>> readers;
+        std::vector<BinaryStringReader*> inputs;
+        for (const std::string& path : paths) {
+            readers.emplace_back(new BinaryStringReader(path, options.ioBufferSize));
+            inputs.push_back(readers.back().get());
+        }
+        LoserTree tree(inputs);
+        while (!tree.isEmpty()) {
+            consume(tree.top());
+            tree.pop();
+        }
+    }
+
+    // Merges the oldest maxMergeWidth runs into one until a single pass
+    // can take all of them.
+    void reduceRuns() {
+        size_t width = options.maxMergeWidth > 1 ? options.maxMergeWidth : 2;
+        while (runFiles.size() > width) {
+            std::vector<std::string> group(runFiles.begin(), runFiles.begin() + width);
+            int count = 0;
+            for (const std::string& path : group) count += BinaryStringReader(path, 64).get_remaining();
+            std::string merged = newRunPath();
+            runFiles.push_back(merged);
+            BinaryStringWriter writer(merged, count, options.ioBufferSize);
+            mergeFiles(group, [&writer](const std::string& str) { writer.write(str); });
+            writer.close();
+            for (const std::string& path : group) std::remove(path.c_str());
+            runFiles.erase(runFiles.begin(), runFiles.begin() + width);
+        }
+    }
+
+    void removeRuns() {
+        for (const std::string& path : runFiles) std::remove(path.c_str());
+        runFiles.clear();
+    }
+
+public:
+    explicit ExternalSorter(const ExternalSortOptions& opts = ExternalSortOptions())
+        : options(opts), runBytes(0), total(0), nextRun(0) {
+        static std::atomic<int> instances(0);
+        prefix = options.tempDirectory + "/extsort-" + std::to_string(getpid()) + "-" +
+                 std::to_string(instances++) + "-";
+    }
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    ~ExternalSorter() {
+        removeRuns();
+    }
+
+    void add(std::string_view value) {
+        run.emplace_back(value);
+        runBytes += value.size() + sizeof(std::string);
+        total++;
+        if (runBytes >= options.memoryBudget) spill();
+    }
+
+    void add(const DynamicArray<std::string>& chunk) {
+        for (int i = 0; i < chunk.get_size(); ++i) add(chunk[i]);
+    }
+
+    // Streams every added string in ascending order to consume(std::string&),
+    // then resets the sorter. The string may be moved from.
+    template <typename Consumer>
+    void merge(Consumer consume) {
+        if (runFiles.empty()) {
+            // Everything fit in memory: no files at all.
+            run.sort(options.threads);
+            for (int i = 0; i < run.get_size(); ++i) consume(run[i]);
+        } else {
+            spill();
+            reduceRuns();
+            mergeFiles(runFiles, consume);
+        }
+        run.clear();
+        runBytes = 0;
+        total = 0;
+        removeRuns();
+    }
+
+    // Writes the sorted strings to filename in the binary format.
+    void finish(const std::string& filename) {
+        if (total > std::numeric_limits<int>::max()) throw std::runtime_error("Too many strings for file: " + filename);
+        BinaryStringWriter writer(filename, static_cast<int>(total), options.ioBufferSize);
+        merge([&writer](const std::string& str) { writer.write(str); });
+        writer.close();
+    }
+
+    int get_run_count() const { return static_cast<int>(runFiles.size()); }
+    long long get_size() const { return total; }
+};
+
+// Sorts the binary string file input into output without loading it whole.
+inline void externalSortFile(const std::string& input, const std::string& output,
+                             const ExternalSortOptions& options = ExternalSortOptions()) {
+    ExternalSorter sorter(options);
+    BinaryStringReader reader(input, options.ioBufferSize);
+    while (reader.next()) sorter.add(reader.value());
+    sorter.finish(output);
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef EYTZINGER_TREE_H
+#define EYTZINGER_TREE_H
+
+#include <climits>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "BinarySearchTree.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Frozen, pointer-free copies of a BinarySearchTree for read-mostly int sets.
+// Both layouts are rebuilt from scratch; further changes to the source tree
+// are not reflected.
+
+template <typename Value>
+std::vector<int> collectSortedKeys(const BinarySearchTree<int, Value>& bst) {
+    return std::vector<int>(bst.begin(), bst.end());
+}
+
+// Eytzinger (BFS) layout: node k has children 2k and 2k+1, slot 0 is unused.
+// The array is 64-byte aligned, so the 16 descendants four levels below k
+// share one cache line and can be prefetched with a single hint.
+class EytzingerTree {
+private:
+    int* keys;
+    int size;
+
+    int fill(const std::vector<int>& sorted, int i, int k) {
+        if (k <= size) {
+            i = fill(sorted, i, 2 * k);
+            keys[k] = sorted[i++];
+            i = fill(sorted, i, 2 * k + 1);
+        }
+        return i;
+    }
+
+    int search(int key) const {
+        int k = 1;
+        while (k <= size) {
+            // In size_t: k << 4 passes INT_MAX once size exceeds 2^27.
+            size_t ahead = static_cast<size_t>(k) << 4;
+            __builtin_prefetch(keys + (ahead <= static_cast<size_t>(size) ? ahead : 0));
+            k = 2 * k + (keys[k] < key);
+        }
+        return k >> __builtin_ffs(~k);
+    }
+
+public:
+    EytzingerTree() : keys(nullptr), size(0) {}
+
+    template <typename Value>
+    explicit EytzingerTree(const BinarySearchTree<int, Value>& bst) : keys(nullptr), size(0) {
+        build(collectSortedKeys(bst));
+    }
+
+    ~EytzingerTree() {
+        ::operator delete(keys, std::align_val_t(64));
+    }
+
+    EytzingerTree(const EytzingerTree&) = delete;
+    EytzingerTree& operator=(const EytzingerTree&) = delete;
+
+    void build(const std::vector<int>& sorted) {
+        ::operator delete(keys, std::align_val_t(64));
+        size = static_cast<int>(sorted.size());
+        keys = static_cast<int*>(::operator new((size + 1) * sizeof(int), std::align_val_t(64)));
+        keys[0] = 0;
+        fill(sorted, 0, 1);
+    }
+
+    bool contains(int key) const {
+        int k = search(key);
+        return k != 0 && keys[k] == key;
+    }
+
+    // Smallest key >= key, or nullptr if every key is smaller.
+    const int* lower_bound(int key) const {
+        int k = search(key);
+        return k != 0 ? keys + k : nullptr;
+    }
+
+    bool isEmpty() const { return size == 0; }
+    int get_size() const { return size; }
+};
+
+// Blocked layout: a static B-tree of 64-byte nodes holding 16 sorted keys with
+// 17 implicit children each, so every level costs one cache miss instead of
+// four. Rank inside a node is computed with AVX2 when available.
+class BlockedEytzingerTree {
+private:
+    static const int B = 16;
+
+    int* keys;
+    int blocks;
+    int size;
+    int filled;
+    bool hasMaxKey;
+
+    static int child(int k, int i) { return k * (B + 1) + i + 1; }
+
+    void fill(const std::vector<int>& sorted, int k) {
+        if (k >= blocks) return;
+        for (int i = 0; i < B; ++i) {
+            fill(sorted, child(k, i));
+            keys[k * B + i] = filled < size ? sorted[filled++] : INT_MAX;
+        }
+        fill(sorted, child(k, B));
+    }
+
+    static int rank(const int* block, int key) {
+#ifdef __AVX2__
+        __m256i x = _mm256_set1_epi32(key);
+        __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 8));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, lo))))
+                      | static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, hi)))) << 8;
+        return __builtin_popcount(mask);
+#else
+        int r = 0;
+        for (int i = 0; i < B; ++i) r += block[i] < key;
+        return r;
+#endif
+    }
+
+    const int* search(int key) const {
+        const int* result = nullptr;
+        int k = 0;
+        while (k < blocks) {
+            const int* block = keys + k * B;
+            int i = rank(block, key);
+            if (i < B) result = block + i;
+            k = child(k, i);
+            if (k < blocks) __builtin_prefetch(keys + k * B);
+        }
+        return result;
+    }
+
+public:
+    BlockedEytzingerTree() : keys(nullptr), blocks(0), size(0), filled(0), hasMaxKey(false) {}
+
+    template <typename Value>
+    explicit BlockedEytzingerTree(const BinarySearchTree<int, Value>& bst)
+        : keys(nullptr), blocks(0), size(0), filled(0), hasMaxKey(false) {
+        build(collectSortedKeys(bst));
+    }
+
+    ~BlockedEytzingerTree() {
+        ::operator delete(keys, std::align_val_t(64));
+    }
+
+    BlockedEytzingerTree(const BlockedEytzingerTree&) = delete;
+    BlockedEytzingerTree& operator=(const BlockedEytzingerTree&) = delete;
+
+    void build(const std::vector<int>& sorted) {
+        ::operator delete(keys, std::align_val_t(64));
+        size = static_cast<int>(sorted.size());
+        blocks = (size + B - 1) / B;
+        keys = static_cast<int*>(::operator new((blocks > 0 ? blocks : 1) * B * sizeof(int), std::align_val_t(64)));
+        filled = 0;
+        fill(sorted, 0);
+        hasMaxKey = size > 0 && sorted.back() == INT_MAX;
+    }
+
+    bool contains(int key) const {
+        const int* found = search(key);
+        return found && *found == key && (key != INT_MAX || hasMaxKey);
+    }
+
+    // Smallest key >= key, or nullptr if every key is smaller.
+    const int* lower_bound(int key) const {
+        const int* found = search(key);
+        if (found && *found == INT_MAX && !hasMaxKey) return nullptr;
+        return found;
+    }
+
+    bool isEmpty() const { return size == 0; }
+    int get_size() const { return size; }
+};
+
+#endif
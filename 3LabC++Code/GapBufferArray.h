@@ -0,0 +1,202 @@
+#ifndef GAP_BUFFER_ARRAY_H
+#define GAP_BUFFER_ARRAY_H
+
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "DynamicArray.h"
+
+// DynamicArray variant for edit streams that stay near a cursor. Storage
+// keeps one movable run of free slots (the gap) at the last edit point:
+// elements [0, gapStart) sit before it and the rest after gapEnd. insert()
+// and remove_at() first move the gap to the index, which relocates only
+// the elements between the old and new edit points, then use or extend
+// the gap in O(1). get/set/get_size behave exactly like DynamicArray.
+template <typename T = std::string>
+class GapBufferArray {
+private:
+    T* data;
+    int capacity;
+    int gapStart;
+    int gapEnd;
+
+    static T* allocate(int n) {
+        return static_cast<T*>(::operator new(sizeof(T) * n));
+    }
+
+    // Relocates count elements from src to dest, where the ranges may
+    // overlap and dest lies gap-ward of src. Walks away from the overlap.
+    static void shift(T* src, int count, T* dest) {
+        if (count <= 0) return;
+        if constexpr (is_trivially_relocatable<T>::value) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(T) * count);
+        } else if (dest > src) {
+            for (int i = count; i-- > 0;) {
+                ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        } else {
+            for (int i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    int gapSize() const { return gapEnd - gapStart; }
+
+    int physical(int index) const {
+        return index < gapStart ? index : index + gapSize();
+    }
+
+    void moveGap(int index) {
+        if (gapStart == gapEnd) {
+            gapStart = gapEnd = index;
+        } else if (index < gapStart) {
+            int count = gapStart - index;
+            shift(data + index, count, data + gapEnd - count);
+            gapStart = index;
+            gapEnd -= count;
+        } else if (index > gapStart) {
+            int count = index - gapStart;
+            shift(data + gapEnd, count, data + gapStart);
+            gapStart = index;
+            gapEnd += count;
+        }
+    }
+
+    // Reallocates with the gap kept at gapStart and widened to fit.
+    void reallocate(int new_capacity) {
+        T* new_data = allocate(new_capacity);
+        int tail = capacity - gapEnd;
+        shift(data, gapStart, new_data);
+        shift(data + gapEnd, tail, new_data + new_capacity - tail);
+        ::operator delete(data);
+        data = new_data;
+        capacity = new_capacity;
+        gapEnd = new_capacity - tail;
+    }
+
+    void destroyAll() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (int i = 0; i < gapStart; ++i) data[i].~T();
+            for (int i = gapEnd; i < capacity; ++i) data[i].~T();
+        }
+    }
+
+    template <typename... Args>
+    void emplaceAt(int index, Args&&... args) {
+        if (gapStart == gapEnd) {
+            // Construct first: args may refer to an element of this array.
+            T value(std::forward<Args>(args)...);
+            reallocate(capacity > 0 ? capacity * 2 : 4);
+            moveGap(index);
+            ::new (static_cast<void*>(data + gapStart)) T(std::move(value));
+        } else {
+            moveGap(index);
+            ::new (static_cast<void*>(data + gapStart)) T(std::forward<Args>(args)...);
+        }
+        gapStart++;
+    }
+
+public:
+    GapBufferArray(int initial_capacity = 4)
+        : capacity(initial_capacity > 0 ? initial_capacity : 4), gapStart(0), gapEnd(capacity) {
+        data = allocate(capacity);
+    }
+
+    GapBufferArray(const GapBufferArray& other) : GapBufferArray(other.get_size()) {
+        for (int i = 0; i < other.get_size(); ++i) {
+            ::new (static_cast<void*>(data + gapStart)) T(other[i]);
+            gapStart++;
+        }
+    }
+
+    GapBufferArray(GapBufferArray&& other) noexcept
+        : data(other.data), capacity(other.capacity), gapStart(other.gapStart), gapEnd(other.gapEnd) {
+        other.data = nullptr;
+        other.capacity = 0;
+        other.gapStart = 0;
+        other.gapEnd = 0;
+    }
+
+    GapBufferArray& operator=(GapBufferArray other) {
+        std::swap(data, other.data);
+        std::swap(capacity, other.capacity);
+        std::swap(gapStart, other.gapStart);
+        std::swap(gapEnd, other.gapEnd);
+        return *this;
+    }
+
+    ~GapBufferArray() {
+        destroyAll();
+        ::operator delete(data);
+    }
+
+    void push_back(const T& value) {
+        emplaceAt(get_size(), value);
+    }
+
+    void push_back(T&& value) {
+        emplaceAt(get_size(), std::move(value));
+    }
+
+    void insert(int index, const T& value) {
+        if (index < 0 || index > get_size()) return;
+        emplaceAt(index, value);
+    }
+
+    void insert(int index, T&& value) {
+        if (index < 0 || index > get_size()) return;
+        emplaceAt(index, std::move(value));
+    }
+
+    T get(int index) const {
+        if (index < 0 || index >= get_size()) return T();
+        return data[physical(index)];
+    }
+
+    // Unchecked access without the copy made by get().
+    T& operator[](int index) { return data[physical(index)]; }
+    const T& operator[](int index) const { return data[physical(index)]; }
+
+    void remove_at(int index) {
+        if (index < 0 || index >= get_size()) return;
+        moveGap(index);
+        data[gapEnd].~T();
+        gapEnd++;
+    }
+
+    void set(int index, const T& value) {
+        if (index < 0 || index >= get_size()) return;
+        data[physical(index)] = value;
+    }
+
+    void set(int index, T&& value) {
+        if (index < 0 || index >= get_size()) return;
+        data[physical(index)] = std::move(value);
+    }
+
+    void print() const {
+        for (int i = 0; i < get_size(); ++i) {
+            std::cout << (*this)[i] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Destroys the elements but keeps the allocated storage.
+    void clear() {
+        destroyAll();
+        gapStart = 0;
+        gapEnd = capacity;
+    }
+
+    int get_size() const { return capacity - gapSize(); }
+    int get_capacity() const { return capacity; }
+    int get_gap_position() const { return gapStart; }
+};
+
+#endif
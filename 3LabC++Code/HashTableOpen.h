@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include "MemoryPolicy.h"
 
 enum EntryStatus { EMPTY, OCCUPIED, DELETED };
 
@@ -19,6 +20,7 @@ private:
     HashEntry* table;
     int size;
     int capacity;
+    MemoryPolicy policy;
 
     int hashFunction(const std::string& key) const {
         int hash = 0;
@@ -27,12 +29,16 @@ private:
     }
 
 public:
-    HashTableOpen(int cap = 101) : size(0), capacity(cap) {
-        table = new HashEntry[capacity];
+    // policy places a large table on huge pages and/or across NUMA nodes.
+    HashTableOpen(int cap = 101, const MemoryPolicy& memory = MemoryPolicy())
+        : size(0), capacity(cap), policy(memory) {
+        table = static_cast<HashEntry*>(allocateWithPolicy(sizeof(HashEntry) * capacity, policy));
+        for (int i = 0; i < capacity; ++i) ::new (static_cast<void*>(table + i)) HashEntry();
     }
 
     ~HashTableOpen() {
-        delete[] table;
+        for (int i = 0; i < capacity; ++i) table[i].~HashEntry();
+        deallocateWithPolicy(table, sizeof(HashEntry) * capacity, policy);
     }
 
     void insert(const std::string& key, const std::string& value) {
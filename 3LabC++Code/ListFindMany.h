@@ -0,0 +1,92 @@
+#ifndef LISTFINDMANY_H
+#define LISTFINDMANY_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Nodes ahead of the cursor whose key bytes are prefetched.
+static const int LIST_PREFETCH_DISTANCE = 4;
+
+// Up to this many queries are compared directly instead of hashed.
+static const size_t LIST_FIND_LINEAR_LIMIT = 8;
+
+// Answers count lookups in one walk over a nullptr-terminated chain:
+// found[i] becomes the first node whose value equals queries[i], or
+// nullptr. The walk stops once every distinct query is answered.
+//
+// A second cursor runs Distance nodes ahead. Loading its next pointer
+// starts the pointer chase early, and the key bytes it will compare
+// (out of line for strings past the small-string buffer) are prefetched,
+// so the work on the current node overlaps the misses of the next ones.
+template <typename Node, std::string Node::*Value, int Distance = LIST_PREFETCH_DISTANCE>
+void findManyInChain(Node* head, const std::string_view* queries, size_t count, Node** found) {
+    static const size_t NONE = static_cast<size_t>(-1);
+    for (size_t i = 0; i < count; ++i) found[i] = nullptr;
+    if (count == 0) return;
+
+    // Distinct values, each with its first query slot; the other slots with
+    // the same value are chained through same. Few queries are deduplicated
+    // and matched by direct comparison, more go through a hash map.
+    std::vector<size_t> same(count, NONE);
+    std::unordered_map<std::string_view, size_t> slots;
+    std::vector<std::string_view> linearValues;
+    std::vector<size_t> linearSlots;
+    bool linear = count <= LIST_FIND_LINEAR_LIMIT;
+    for (size_t i = 0; i < count; ++i) {
+        size_t first = NONE;
+        if (linear) {
+            for (size_t j = 0; j < linearValues.size() && first == NONE; ++j) {
+                if (linearValues[j] == queries[i]) first = linearSlots[j];
+            }
+            if (first == NONE) {
+                linearValues.push_back(queries[i]);
+                linearSlots.push_back(i);
+            }
+        } else {
+            auto inserted = slots.emplace(queries[i], i);
+            if (!inserted.second) first = inserted.first->second;
+        }
+        if (first != NONE) {
+            same[i] = same[first];
+            same[first] = i;
+        }
+    }
+    size_t pending = linear ? linearValues.size() : slots.size();
+
+    Node* ahead = head;
+    for (int i = 0; i < Distance && ahead; ++i) ahead = ahead->next;
+    for (Node* node = head; node && pending > 0; node = node->next) {
+        if (Distance > 0 && ahead) {
+            __builtin_prefetch((ahead->*Value).data());
+            ahead = ahead->next;
+        }
+        std::string_view value = node->*Value;
+        size_t slot = NONE;
+        if (linear) {
+            for (size_t j = 0; j < linearValues.size(); ++j) {
+                if (linearValues[j] == value) {
+                    slot = linearSlots[j];
+                    linearValues[j] = linearValues.back();
+                    linearSlots[j] = linearSlots.back();
+                    linearValues.pop_back();
+                    linearSlots.pop_back();
+                    break;
+                }
+            }
+        } else {
+            auto it = slots.find(value);
+            if (it != slots.end()) {
+                slot = it->second;
+                slots.erase(it);
+            }
+        }
+        if (slot == NONE) continue;
+        for (; slot != NONE; slot = same[slot]) found[slot] = node;
+        pending--;
+    }
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef LISTINDEX_H
+#define LISTINDEX_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// Where a node was linked, relative to the other nodes holding its value.
+enum class ListPosition { Front, Back, Middle };
+
+// Optional hash index of a linked list: value -> first node holding it.
+// Keys are views of the strings inside the nodes, so values are not stored
+// twice. The list reports every linked and unlinked node; with distinct
+// values all lookups are O(1). A duplicate linked in the middle makes the
+// first occurrence unknown, and the next lookup of that value rescans the
+// list once; removing the indexed node of a duplicated value rescans too.
+// Values must not be changed through node pointers while indexed.
+template <typename Node, std::string Node::*Value>
+class ListIndex {
+private:
+    struct Entry {
+        Node* node;   // some node holding the value; the first if exact
+        int count;
+        bool exact;
+    };
+
+    using Map = std::unordered_map<std::string_view, Entry>;
+    Map map;
+
+    static std::string_view keyOf(const Node* node) { return node->*Value; }
+
+    static Node* firstFrom(Node* head, std::string_view value, const Node* skip) {
+        for (Node* node = head; node; node = node->next) {
+            if (node != skip && keyOf(node) == value) return node;
+        }
+        return nullptr;
+    }
+
+    // The key must view a live node, so it moves along with the entry.
+    void repoint(typename Map::iterator it, Node* node) {
+        if (it->second.node == node) return;
+        auto handle = map.extract(it);
+        handle.key() = keyOf(node);
+        handle.mapped().node = node;
+        map.insert(std::move(handle));
+    }
+
+public:
+    // Call after node is linked.
+    void added(Node* node, ListPosition position) {
+        auto it = map.find(keyOf(node));
+        if (it == map.end()) {
+            map.emplace(keyOf(node), Entry{node, 1, true});
+            return;
+        }
+        Entry& entry = it->second;
+        entry.count++;
+        if (position == ListPosition::Front) {
+            entry.exact = true;
+            repoint(it, node);
+        } else if (position == ListPosition::Middle) {
+            entry.exact = false;
+        }
+    }
+
+    // Call after a node already in the list is moved to another position.
+    void relinked(Node* node, ListPosition position) {
+        auto it = map.find(keyOf(node));
+        if (it == map.end()) return;
+        if (position == ListPosition::Front) {
+            it->second.exact = true;
+            repoint(it, node);
+        } else if (it->second.count > 1) {
+            it->second.exact = false;
+        }
+    }
+
+    // Call before node is unlinked, or after a whole chain containing it
+    // was detached; head is the current list head. In the second case the
+    // other occurrences may all sit in the detached chain and be reported
+    // next, so the entry keeps its node until the count drops to zero.
+    void removed(Node* node, Node* head) {
+        auto it = map.find(keyOf(node));
+        if (it == map.end()) return;
+        if (--it->second.count == 0) {
+            map.erase(it);
+            return;
+        }
+        if (it->second.node == node) {
+            Node* first = firstFrom(head, keyOf(node), node);
+            if (!first) return;
+            it->second.exact = true;
+            repoint(it, first);
+        }
+    }
+
+    // First node holding value, or nullptr.
+    Node* first(std::string_view value, Node* head) {
+        auto it = map.find(value);
+        if (it == map.end()) return nullptr;
+        if (!it->second.exact) {
+            it->second.exact = true;
+            repoint(it, firstFrom(head, value, nullptr));
+        }
+        return it->second.node;
+    }
+
+    void clear() { map.clear(); }
+
+    // Approximate heap bytes: bucket array plus one map node per distinct
+    // value (key view, entry, next pointer, cached hash, malloc header).
+    size_t memory_usage() const {
+        size_t perNode = sizeof(std::string_view) + sizeof(Entry) + 2 * sizeof(void*) + 16;
+        return map.bucket_count() * sizeof(void*) + map.size() * perNode;
+    }
+
+    size_t distinct_values() const { return map.size(); }
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef LISTSORT_H
+#define LISTSORT_H
+
+#include <string>
+
+// Relinking merge and sort over nullptr-terminated chains linked by next.
+// Only next pointers are written; a doubly linked list restores prev in
+// one pass afterwards. Strings are never copied or moved.
+
+// Merges two ascending chains; on equal values a's node comes first.
+template <typename Node, std::string Node::*Value>
+Node* mergeChains(Node* a, Node* b) {
+    Node* result = nullptr;
+    Node** link = &result;
+    while (a && b) {
+        if (b->*Value < a->*Value) {
+            *link = b;
+            b = b->next;
+        } else {
+            *link = a;
+            a = a->next;
+        }
+        link = &(*link)->next;
+    }
+    *link = a ? a : b;
+    return result;
+}
+
+// Stable bottom-up merge sort: bins[i] holds a sorted run of 2^i nodes,
+// each taken node carries into the bins like a binary counter. O(n log n)
+// comparisons, no recursion, 64 pointers of extra space.
+template <typename Node, std::string Node::*Value>
+Node* sortChain(Node* head) {
+    Node* bins[64] = {};
+    int used = 0;
+    while (head) {
+        Node* carry = head;
+        head = head->next;
+        carry->next = nullptr;
+        int i = 0;
+        for (; i < used && bins[i]; ++i) {
+            carry = mergeChains<Node, Value>(bins[i], carry);
+            bins[i] = nullptr;
+        }
+        bins[i] = carry;
+        if (i == used) used++;
+    }
+    Node* result = nullptr;
+    for (int i = 0; i < used; ++i) {
+        if (bins[i]) result = mergeChains<Node, Value>(bins[i], result);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef MAPPED_ARRAY_H
+#define MAPPED_ARRAY_H
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Kernel readahead hint for a mapping (madvise).
+enum class MappedAccess { Normal, Sequential, Random };
+
+// Array of trivially copyable elements living in a shared memory mapping of
+// a file, for datasets larger than RAM. The file is a 32-byte header
+// (magic, element size, element count) followed by the raw elements, so
+// opening an existing file only maps it: nothing is parsed or copied and
+// pages are read lazily on first touch. Growth extends the file with
+// ftruncate and the mapping with mremap.
+//
+// Writes reach the file through the page cache; flush() forces them to
+// disk. Sizes are size_t rather than int since the data may exceed 2^31
+// elements.
+template <typename T>
+class MappedArray {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedArray stores raw bytes");
+
+public:
+    using Access = MappedAccess;
+
+private:
+    static const uint64_t MAGIC = 0x59415252414D4150ULL;  // "PAMARRAY"
+
+    struct Header {
+        uint64_t magic;
+        uint64_t elementSize;
+        uint64_t size;
+        uint64_t reserved;
+    };
+
+    std::string filename;
+    int fd;
+    char* base;
+    size_t mappedBytes;
+    Access access;
+
+    Header* header() const { return reinterpret_cast<Header*>(base); }
+    T* data() const { return reinterpret_cast<T*>(base + sizeof(Header)); }
+
+    static size_t bytesFor(size_t capacity) { return sizeof(Header) + capacity * sizeof(T); }
+
+    void applyAdvice() {
+        int advice = access == Access::Sequential ? MADV_SEQUENTIAL
+                   : access == Access::Random     ? MADV_RANDOM
+                                                  : MADV_NORMAL;
+        madvise(base, mappedBytes, advice);
+    }
+
+    void map(size_t bytes) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot map file: " + filename);
+        base = static_cast<char*>(p);
+        mappedBytes = bytes;
+    }
+
+    void resize(size_t bytes) {
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) throw std::runtime_error("Cannot grow file: " + filename);
+#ifdef __linux__
+        void* p = mremap(base, mappedBytes, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot map file: " + filename);
+        base = static_cast<char*>(p);
+        mappedBytes = bytes;
+#else
+        munmap(base, mappedBytes);
+        map(bytes);
+#endif
+        applyAdvice();
+    }
+
+    void grow(size_t needed) {
+        size_t capacity = get_capacity();
+        while (capacity < needed) capacity = capacity > 0 ? capacity * 2 : 1024;
+        resize(bytesFor(capacity));
+    }
+
+public:
+    // Opens filename, creating it with room for initial_capacity elements
+    // if it does not exist.
+    explicit MappedArray(const std::string& name, size_t initial_capacity = 1024)
+        : filename(name), fd(-1), base(nullptr), mappedBytes(0), access(Access::Normal) {
+        fd = open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) throw std::runtime_error("Cannot open file: " + filename);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot open file: " + filename);
+        }
+        try {
+            if (st.st_size == 0) {
+                if (initial_capacity == 0) initial_capacity = 1;
+                if (ftruncate(fd, static_cast<off_t>(bytesFor(initial_capacity))) != 0) {
+                    throw std::runtime_error("Cannot grow file: " + filename);
+                }
+                map(bytesFor(initial_capacity));
+                *header() = Header{MAGIC, sizeof(T), 0, 0};
+            } else {
+                if (static_cast<size_t>(st.st_size) < sizeof(Header)) {
+                    throw std::runtime_error("Not a MappedArray file: " + filename);
+                }
+                map(static_cast<size_t>(st.st_size));
+                if (header()->magic != MAGIC || header()->elementSize != sizeof(T) ||
+                    bytesFor(header()->size) > mappedBytes) {
+                    munmap(base, mappedBytes);
+                    throw std::runtime_error("Not a MappedArray file: " + filename);
+                }
+            }
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+    }
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    ~MappedArray() {
+        munmap(base, mappedBytes);
+        close(fd);
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity > get_capacity()) resize(bytesFor(new_capacity));
+    }
+
+    void push_back(const T& value) {
+        T copy = value;  // value may live in the mapping that grow() moves
+        if (get_size() == get_capacity()) grow(get_size() + 1);
+        data()[header()->size++] = copy;
+    }
+
+    // Appends count elements with at most one remap.
+    void append(const T* values, size_t count) {
+        if (count == 0) return;
+        size_t size = get_size();
+        if (size + count > get_capacity()) {
+            if (values >= data() && values < data() + get_capacity()) {
+                // Source lives in this mapping; append in two safe steps.
+                size_t offset = values - data();
+                grow(size + count);
+                std::memmove(data() + size, data() + offset, count * sizeof(T));
+                header()->size += count;
+                return;
+            }
+            grow(size + count);
+        }
+        std::memmove(data() + size, values, count * sizeof(T));
+        header()->size += count;
+    }
+
+    void pop_back() {
+        if (get_size() > 0) header()->size--;
+    }
+
+    T get(size_t index) const {
+        if (index >= get_size()) return T();
+        return data()[index];
+    }
+
+    void set(size_t index, const T& value) {
+        if (index >= get_size()) return;
+        data()[index] = value;
+    }
+
+    // Unchecked access straight into the mapping.
+    T& operator[](size_t index) { return data()[index]; }
+    const T& operator[](size_t index) const { return data()[index]; }
+
+    void advise(Access pattern) {
+        access = pattern;
+        applyAdvice();
+    }
+
+    // Writes dirty pages back to the file and waits for the disk.
+    void flush() {
+        if (msync(base, mappedBytes, MS_SYNC) != 0) throw std::runtime_error("Cannot flush file: " + filename);
+    }
+
+    void print() const {
+        for (size_t i = 0; i < get_size(); ++i) {
+            std::cout << data()[i] << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Drops the elements; the file keeps its size.
+    void clear() { header()->size = 0; }
+
+    size_t get_size() const { return header()->size; }
+    size_t get_capacity() const { return (mappedBytes - sizeof(Header)) / sizeof(T); }
+};
+
+// Strings on disk in the offset + blob layout: filename.idx holds an
+// {offset, length} span per element and filename.blob the bytes. get()
+// returns a view straight into the mapping, valid until the next append.
+// set() with a different length appends the new bytes and leaves the old
+// ones unreferenced.
+class MappedStringArray {
+public:
+    using Access = MappedAccess;
+
+private:
+    struct Span {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    MappedArray<Span> spans;
+    MappedArray<char> blob;
+
+    Span store(std::string_view value) {
+        Span span{blob.get_size(), value.size()};
+        blob.append(value.data(), value.size());
+        return span;
+    }
+
+public:
+    explicit MappedStringArray(const std::string& filename, size_t initial_capacity = 1024)
+        : spans(filename + ".idx", initial_capacity), blob(filename + ".blob", initial_capacity * 16) {}
+
+    void push_back(std::string_view value) {
+        spans.push_back(store(value));
+    }
+
+    std::string_view get(size_t index) const {
+        if (index >= get_size()) return std::string_view();
+        Span span = spans[index];
+        return std::string_view(&blob[0] + span.offset, span.length);
+    }
+
+    void set(size_t index, std::string_view value) {
+        if (index >= get_size()) return;
+        Span span = spans[index];
+        if (span.length == value.size()) {
+            std::memmove(&blob[0] + span.offset, value.data(), value.size());
+        } else {
+            spans[index] = store(value);
+        }
+    }
+
+    void advise(Access pattern) {
+        spans.advise(pattern);
+        blob.advise(pattern);
+    }
+
+    void flush() {
+        blob.flush();
+        spans.flush();
+    }
+
+    void print() const {
+        for (size_t i = 0; i < get_size(); ++i) {
+            std::cout << get(i) << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    void clear() {
+        spans.clear();
+        blob.clear();
+    }
+
+    size_t get_size() const { return spans.get_size(); }
+};
+
+#endif
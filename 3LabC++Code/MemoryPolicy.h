@@ -0,0 +1,157 @@
+#ifndef MEMORY_POLICY_H
+#define MEMORY_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Placement of large container buffers.
+//   Local       kernel default: pages land on the node of the first writer
+//   Interleave  pages spread round-robin over all online NUMA nodes (mbind)
+//   FirstTouch  pages are faulted in by one thread per hardware thread right
+//               after allocation, so each node backs the part its CPUs touched
+enum class NumaPolicy { Local, Interleave, FirstTouch };
+
+struct MemoryPolicy {
+    bool hugePages;
+    NumaPolicy numa;
+
+    MemoryPolicy(bool huge = false, NumaPolicy placement = NumaPolicy::Local) : hugePages(huge), numa(placement) {}
+
+    bool isDefault() const { return !hugePages && numa == NumaPolicy::Local; }
+};
+
+// Buffers below one huge page always come from operator new; the policy
+// only changes how larger ones are mapped. Unsupported steps (no THP, one
+// NUMA node, non-Linux) are skipped and the memory is still usable.
+static const size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+inline bool policyMapsBuffer(size_t bytes, const MemoryPolicy& policy) {
+#ifdef __linux__
+    return !policy.isDefault() && bytes >= HUGE_PAGE_SIZE;
+#else
+    (void)bytes;
+    (void)policy;
+    return false;
+#endif
+}
+
+inline size_t policyMappedBytes(size_t bytes) {
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+#ifdef __linux__
+// Bit mask of online NUMA nodes from sysfs ("0-1,3"); 0 if unknown.
+inline unsigned long numaOnlineNodes() {
+    static const unsigned long mask = []() {
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string ranges;
+        unsigned long nodes = 0;
+        if (!(file >> ranges)) return nodes;
+        size_t pos = 0;
+        while (pos < ranges.size()) {
+            size_t end = ranges.find(',', pos);
+            if (end == std::string::npos) end = ranges.size();
+            std::string part = ranges.substr(pos, end - pos);
+            size_t dash = part.find('-');
+            unsigned long first = std::stoul(part.substr(0, dash));
+            unsigned long last = dash == std::string::npos ? first : std::stoul(part.substr(dash + 1));
+            for (unsigned long n = first; n <= last && n < 8 * sizeof(unsigned long); ++n) nodes |= 1UL << n;
+            pos = end + 1;
+        }
+        return nodes;
+    }();
+    return mask;
+}
+
+inline void numaInterleave(void* p, size_t bytes) {
+    const int MPOL_INTERLEAVE_MODE = 3;
+    unsigned long nodes = numaOnlineNodes();
+    if (__builtin_popcountl(nodes) < 2) return;
+    // Raw syscall so there is no libnuma dependency; failure keeps Local.
+    syscall(SYS_mbind, p, bytes, MPOL_INTERLEAVE_MODE, &nodes, 8 * sizeof(unsigned long), 0);
+}
+
+// Faults in every page, one contiguous slice per hardware thread.
+inline void numaFirstTouch(void* p, size_t bytes) {
+    unsigned threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    const size_t page = 4096;
+    size_t pages = bytes / page;
+    size_t slice = (pages + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t first = t * slice;
+        size_t last = first + slice < pages ? first + slice : pages;
+        if (first >= last) break;
+        workers.emplace_back([p, first, last, page]() {
+            volatile char* bytesPtr = static_cast<char*>(p);
+            for (size_t i = first; i < last; ++i) bytesPtr[i * page] = 0;
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+}
+#endif
+
+inline void* allocateWithPolicy(size_t bytes, const MemoryPolicy& policy) {
+#ifdef __linux__
+    if (policyMapsBuffer(bytes, policy)) {
+        size_t length = policyMappedBytes(bytes);
+        // Over-map by one huge page and trim, so the buffer is 2 MB aligned
+        // and every part of it can be backed by huge pages.
+        size_t padded = length + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(uintptr_t(HUGE_PAGE_SIZE) - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        size_t tail = start + padded - (aligned + length);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + length), tail);
+        void* p = reinterpret_cast<void*>(aligned);
+        if (policy.hugePages) madvise(p, length, MADV_HUGEPAGE);
+        if (policy.numa == NumaPolicy::Interleave) numaInterleave(p, length);
+        if (policy.numa == NumaPolicy::FirstTouch) numaFirstTouch(p, length);
+        return p;
+    }
+#endif
+    return ::operator new(bytes);
+}
+
+inline void deallocateWithPolicy(void* p, size_t bytes, const MemoryPolicy& policy) {
+    if (!p) return;
+#ifdef __linux__
+    if (policyMapsBuffer(bytes, policy)) {
+        munmap(p, policyMappedBytes(bytes));
+        return;
+    }
+#endif
+    ::operator delete(p);
+}
+
+// Allocator hook of DynamicArray. The default keeps plain operator new and
+// adds no state to the array.
+struct HeapArrayAllocator {
+    void* allocate(size_t bytes) const { return ::operator new(bytes); }
+    void deallocate(void* p, size_t) const { ::operator delete(p); }
+};
+
+struct PolicyArrayAllocator {
+    MemoryPolicy policy;
+
+    PolicyArrayAllocator(const MemoryPolicy& p = MemoryPolicy()) : policy(p) {}
+
+    void* allocate(size_t bytes) const { return allocateWithPolicy(bytes, policy); }
+    void deallocate(void* p, size_t bytes) const { deallocateWithPolicy(p, bytes, policy); }
+};
+
+#endif
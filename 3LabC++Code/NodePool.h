@@ -0,0 +1,226 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+// Where a linked container gets its nodes from.
+//   heap()  one operator new / delete per node (the default)
+//   pool()  nodes are carved out of 16 KB slabs owned by the container;
+//           freed nodes go on the container's free list and clear() hands
+//           every slab back at once. Slabs come from the given
+//           memory_resource, or else from a cache of free slabs kept per
+//           thread and shared by all pooled containers of that thread.
+//
+// The pool is not a thread-local free list of nodes: a freed node is only
+// reused by the container that freed it, and what containers of one thread
+// share is whole empty slabs, returned by clear() or destruction. Keeping
+// each slab with one container is what lets clear() drop all nodes in
+// O(slabs) and lets splice / merge hand slabs to another list (adopt()).
+struct NodeAllocator {
+    bool pooled;
+    std::pmr::memory_resource* resource;
+
+    NodeAllocator(bool pool = false, std::pmr::memory_resource* res = nullptr)
+        : pooled(pool || res != nullptr), resource(res) {}
+
+    static NodeAllocator heap() { return NodeAllocator(); }
+    static NodeAllocator pool(std::pmr::memory_resource* res = nullptr) { return NodeAllocator(true, res); }
+};
+
+static const size_t NODE_SLAB_BYTES = 16384;
+
+// Free slabs of the calling thread (empty slabs only; nodes are never
+// cached here individually). A slab is plain memory with no owner
+// recorded, so it may be taken on one thread and given back on another.
+// The state is trivially destructible and stays valid until the thread
+// ends; the drain object empties it at thread exit and from then on slabs
+// go straight back to operator delete.
+struct NodeSlabCache {
+    static const size_t MAX_CACHED = 64;
+
+    struct FreeSlab {
+        FreeSlab* next;
+    };
+
+    FreeSlab* slabs;
+    size_t count;
+    bool closed;
+
+    static NodeSlabCache& local() {
+        thread_local NodeSlabCache cache = {nullptr, 0, false};
+        struct Drain {
+            ~Drain() {
+                NodeSlabCache& c = local();
+                while (c.slabs) {
+                    FreeSlab* next = c.slabs->next;
+                    ::operator delete(c.slabs);
+                    c.slabs = next;
+                }
+                c.count = 0;
+                c.closed = true;
+            }
+        };
+        thread_local Drain drain;
+        (void)drain;
+        return cache;
+    }
+
+    void* take() {
+        if (!slabs) return ::operator new(NODE_SLAB_BYTES);
+        FreeSlab* slab = slabs;
+        slabs = slab->next;
+        count--;
+        return slab;
+    }
+
+    void give(void* p) {
+        if (closed || count >= MAX_CACHED) {
+            ::operator delete(p);
+            return;
+        }
+        FreeSlab* slab = static_cast<FreeSlab*>(p);
+        slab->next = slabs;
+        slabs = slab;
+        count++;
+    }
+};
+
+// Node storage of one container, used as create()/destroy() in place of
+// new/delete. With a heap allocator it is exactly new/delete.
+template <typename Node>
+class NodeArena {
+private:
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    struct Slab {
+        Slab* next;
+    };
+
+    static const size_t SLAB_HEADER = (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    static const size_t SLOTS_PER_SLAB = (NODE_SLAB_BYTES - SLAB_HEADER) / sizeof(Slot);
+    static_assert(SLOTS_PER_SLAB > 0, "node larger than a slab");
+    static_assert(alignof(Slot) <= alignof(std::max_align_t), "over-aligned node");
+
+    NodeAllocator source;
+    Slab* slabs;
+    Slot* freeSlots;
+    Slot* fresh;      // untouched part of the newest slab
+    Slot* freshEnd;
+
+    void* takeSlot() {
+        if (freeSlots) {
+            Slot* slot = freeSlots;
+            freeSlots = slot->next;
+            return slot;
+        }
+        if (fresh == freshEnd) {
+            void* memory = source.resource ? source.resource->allocate(NODE_SLAB_BYTES, alignof(std::max_align_t))
+                                           : NodeSlabCache::local().take();
+            Slab* slab = static_cast<Slab*>(memory);
+            slab->next = slabs;
+            slabs = slab;
+            fresh = reinterpret_cast<Slot*>(static_cast<char*>(memory) + SLAB_HEADER);
+            freshEnd = fresh + SLOTS_PER_SLAB;
+        }
+        return fresh++;
+    }
+
+    void giveSlot(void* p) {
+        Slot* slot = static_cast<Slot*>(p);
+        slot->next = freeSlots;
+        freeSlots = slot;
+    }
+
+public:
+    explicit NodeArena(const NodeAllocator& alloc = NodeAllocator())
+        : source(alloc), slabs(nullptr), freeSlots(nullptr), fresh(nullptr), freshEnd(nullptr) {}
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    // The owning container destroys its nodes first.
+    ~NodeArena() {
+        release();
+    }
+
+    template <typename... Args>
+    Node* create(Args&&... args) {
+        if (!source.pooled) return new Node(std::forward<Args>(args)...);
+        void* p = takeSlot();
+        try {
+            return new (p) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            giveSlot(p);
+            throw;
+        }
+    }
+
+    void destroy(Node* node) {
+        if (!source.pooled) {
+            delete node;
+            return;
+        }
+        node->~Node();
+        giveSlot(node);
+    }
+
+    // Destroys a node whose slot is reclaimed by the next release(); used
+    // by clear() so the slots are not threaded onto the free list first.
+    void dispose(Node* node) {
+        if (!source.pooled) {
+            delete node;
+            return;
+        }
+        node->~Node();
+    }
+
+    // Returns every slab at once. All nodes must already be destroyed.
+    void release() {
+        while (slabs) {
+            Slab* next = slabs->next;
+            if (source.resource) {
+                source.resource->deallocate(slabs, NODE_SLAB_BYTES, alignof(std::max_align_t));
+            } else {
+                NodeSlabCache::local().give(slabs);
+            }
+            slabs = next;
+        }
+        freeSlots = fresh = freshEnd = nullptr;
+    }
+
+    // True if other's nodes can change hands without being copied: both
+    // use new/delete, or both pool slabs from the same place.
+    bool canAdopt(const NodeArena& other) const {
+        return source.pooled == other.source.pooled && source.resource == other.source.resource;
+    }
+
+    // Takes over all slabs and free slots of other (see canAdopt), so nodes
+    // created by other may be destroyed here.
+    void adopt(NodeArena& other) {
+        if (!source.pooled || this == &other) return;
+        if (other.slabs) {
+            Slab* last = other.slabs;
+            while (last->next) last = last->next;
+            last->next = slabs;
+            slabs = other.slabs;
+        }
+        while (other.freeSlots) {
+            Slot* slot = other.freeSlots;
+            other.freeSlots = slot->next;
+            giveSlot(slot);
+        }
+        // The untouched rest of other's newest slab is given up until release().
+        other.slabs = nullptr;
+        other.fresh = other.freshEnd = nullptr;
+    }
+
+    const NodeAllocator& get_allocator() const { return source; }
+};
+
+#endif
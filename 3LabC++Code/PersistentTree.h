@@ -0,0 +1,319 @@
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BinarySearchTree.h"
+
+// Immutable node of a PersistentTree. Nodes are never modified once a
+// version containing them has been published.
+template <typename Key, typename Value>
+struct PersistentNode : TreeNodeValue<Value> {
+    Key key;
+    std::shared_ptr<PersistentNode> left;
+    std::shared_ptr<PersistentNode> right;
+
+    PersistentNode(const Key& k) : key(k) {}
+
+    // Releases uniquely owned descendants iteratively, so dropping the last
+    // reference to a degenerate version does not recurse once per level.
+    ~PersistentNode() {
+        std::vector<std::shared_ptr<PersistentNode>> pending;
+        pending.push_back(std::move(left));
+        pending.push_back(std::move(right));
+        while (!pending.empty()) {
+            std::shared_ptr<PersistentNode> node = std::move(pending.back());
+            pending.pop_back();
+            if (node && node.use_count() == 1) {
+                // use_count() is a relaxed load. Copying the pointer is an
+                // acquire on the count, ordering the previous owners' last
+                // use before the children are taken (a standalone fence would
+                // do the same, but ThreadSanitizer does not model fences).
+                std::shared_ptr<PersistentNode> acquired = node;
+                pending.push_back(std::move(node->left));
+                pending.push_back(std::move(node->right));
+            }
+        }
+    }
+};
+
+// The published root. Readers never lock or wait: a reader counts itself
+// in the current epoch, loads the version pointer and copies the root
+// shared_ptr out of it. The writer swaps in a new version, moves the epoch
+// on, and deletes the old version once the readers counted in the previous
+// epoch have left; they hold it only for that one copy. A reader that saw
+// the epoch change under it retries, so a reader is held up only by a
+// writer making progress. Stores must be serialized by the caller.
+template <typename T>
+class SharedRoot {
+private:
+    struct Version {
+        std::shared_ptr<T> ptr;
+    };
+
+    std::atomic<Version*> current;
+    std::atomic<unsigned> epoch;
+    mutable std::atomic<unsigned> readers[2];
+
+public:
+    SharedRoot() : current(new Version()), epoch(0), readers{{0}, {0}} {}
+
+    SharedRoot(const SharedRoot&) = delete;
+    SharedRoot& operator=(const SharedRoot&) = delete;
+
+    ~SharedRoot() {
+        delete current.load();
+    }
+
+    std::shared_ptr<T> load() const {
+        unsigned e = epoch.load();
+        for (;;) {
+            readers[e & 1].fetch_add(1);
+            unsigned now = epoch.load();
+            if (now == e) break;
+            readers[e & 1].fetch_sub(1);
+            e = now;
+        }
+        std::shared_ptr<T> ptr = current.load()->ptr;
+        readers[e & 1].fetch_sub(1);
+        return ptr;
+    }
+
+    // Readers that load after the exchange get the new version, and every
+    // reader still counted in the old epoch started before the epoch moved,
+    // so once that count drains nobody can reach the old version. The old
+    // root is released here, on the writer's thread, unless a snapshot
+    // still holds it.
+    void store(std::shared_ptr<T> next) {
+        Version* old = current.exchange(new Version{std::move(next)});
+        unsigned e = epoch.load();
+        epoch.store(e + 1);
+        while (readers[e & 1].load() != 0) std::this_thread::yield();
+        delete old;
+    }
+};
+
+// Path-copying binary search tree. Every insert/remove copies only the
+// nodes on the root-to-key path and publishes the new root with one atomic
+// exchange; unchanged subtrees are shared between versions. Readers take a
+// Snapshot without locking (see SharedRoot) and query it without ever
+// seeing a partial update. Old versions are reclaimed by reference
+// counting when the last snapshot holding them goes away. Writers are
+// serialized by an internal mutex.
+template <typename Key = int, typename Value = void, typename Compare = std::less<Key>>
+class PersistentTree {
+public:
+    using Node = PersistentNode<Key, Value>;
+    using NodePtr = std::shared_ptr<Node>;
+
+private:
+    using KeyCompare = TreeKeyCompare<Key, Compare>;
+
+    struct PathStep {
+        const Node* node;
+        bool wentLeft;
+    };
+
+    SharedRoot<Node> root;
+    Compare comp;
+    std::mutex writer;
+
+    static NodePtr copyNode(const Node* node) {
+        NodePtr copy = std::make_shared<Node>(node->key);
+        if constexpr (!std::is_void<Value>::value) {
+            copy->value = node->value;
+        }
+        copy->left = node->left;
+        copy->right = node->right;
+        return copy;
+    }
+
+    // Walks from the root towards key, recording the path. Returns the node
+    // holding key, or nullptr if it is absent.
+    const Node* descend(const Node* node, const Key& key, std::vector<PathStep>& path) const {
+        while (node) {
+            int c = KeyCompare::compare(comp, key, node->key);
+            if (c == 0) break;
+            path.push_back({node, c < 0});
+            node = c < 0 ? node->left.get() : node->right.get();
+        }
+        return node;
+    }
+
+    // Copies the recorded path bottom-up, hanging subtree under the last step.
+    static NodePtr rebuild(const std::vector<PathStep>& path, NodePtr subtree) {
+        for (size_t i = path.size(); i-- > 0;) {
+            NodePtr copy = copyNode(path[i].node);
+            (path[i].wentLeft ? copy->left : copy->right) = std::move(subtree);
+            subtree = std::move(copy);
+        }
+        return subtree;
+    }
+
+    void publish(NodePtr next) {
+        root.store(std::move(next));
+    }
+
+    template <typename Assign>
+    void upsert(const Key& key, Assign assign) {
+        std::lock_guard<std::mutex> lock(writer);
+        NodePtr current = root.load();
+        std::vector<PathStep> path;
+        const Node* found = descend(current.get(), key, path);
+        NodePtr node;
+        if (found) {
+            node = copyNode(found);
+        } else {
+            node = std::make_shared<Node>(key);
+        }
+        if (!assign(*node) && found) return;
+        publish(rebuild(path, std::move(node)));
+    }
+
+public:
+    // Immutable view of one published version.
+    class Snapshot {
+    private:
+        NodePtr root;
+        Compare comp;
+
+        const Node* findNode(const Key& key) const {
+            const Node* node = root.get();
+            while (node) {
+                int c = KeyCompare::compare(comp, key, node->key);
+                if (c == 0) break;
+                node = c < 0 ? node->left.get() : node->right.get();
+            }
+            return node;
+        }
+
+    public:
+        class const_iterator {
+        private:
+            std::vector<const Node*> stack;
+
+            void pushLeft(const Node* node) {
+                while (node) {
+                    stack.push_back(node);
+                    node = node->left.get();
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Key;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Key*;
+            using reference = const Key&;
+
+            const_iterator() {}
+            explicit const_iterator(const Node* root) { pushLeft(root); }
+
+            reference operator*() const { return stack.back()->key; }
+            pointer operator->() const { return &stack.back()->key; }
+
+            const_iterator& operator++() {
+                const Node* node = stack.back();
+                stack.pop_back();
+                pushLeft(node->right.get());
+                return *this;
+            }
+
+            bool operator==(const const_iterator& other) const {
+                if (stack.empty() || other.stack.empty()) return stack.empty() == other.stack.empty();
+                return stack.back() == other.stack.back();
+            }
+            bool operator!=(const const_iterator& other) const { return !(*this == other); }
+        };
+
+        Snapshot(NodePtr r, const Compare& c) : root(std::move(r)), comp(c) {}
+
+        bool contains(const Key& key) const {
+            return findNode(key) != nullptr;
+        }
+
+        // Mapped value for the key, or nullptr if the key is absent.
+        template <typename V = Value>
+        const typename std::enable_if<!std::is_void<V>::value, V>::type* find(const Key& key) const {
+            const Node* node = findNode(key);
+            return node ? &node->value : nullptr;
+        }
+
+        bool isEmpty() const { return root == nullptr; }
+
+        const_iterator begin() const { return const_iterator(root.get()); }
+        const_iterator end() const { return const_iterator(); }
+
+        const Node* getRoot() const { return root.get(); }
+    };
+
+    PersistentTree(const Compare& compare = Compare()) : comp(compare) {}
+
+    PersistentTree(const PersistentTree&) = delete;
+    PersistentTree& operator=(const PersistentTree&) = delete;
+
+    Snapshot snapshot() const {
+        return Snapshot(root.load(), comp);
+    }
+
+    void insert(const Key& key) {
+        upsert(key, [](Node&) { return false; });
+    }
+
+    // Inserts the key or publishes a version with the value replaced.
+    template <typename V = Value>
+    void insert(const Key& key, const typename std::enable_if<!std::is_void<V>::value, V>::type& value) {
+        upsert(key, [&value](Node& node) { node.value = value; return true; });
+    }
+
+    void remove(const Key& key) {
+        std::lock_guard<std::mutex> lock(writer);
+        NodePtr current = root.load();
+        std::vector<PathStep> path;
+        const Node* found = descend(current.get(), key, path);
+        if (!found) return;
+
+        NodePtr replacement;
+        if (!found->left) {
+            replacement = found->right;
+        } else if (!found->right) {
+            replacement = found->left;
+        } else {
+            // Copy the left spine of the right subtree down to the successor,
+            // dropping the successor from it, then give the successor's key
+            // to a fresh copy of the removed node.
+            std::vector<PathStep> spine;
+            const Node* succ = found->right.get();
+            while (succ->left) {
+                spine.push_back({succ, true});
+                succ = succ->left.get();
+            }
+            replacement = copyNode(succ);
+            replacement->left = found->left;
+            replacement->right = rebuild(spine, succ->right);
+        }
+        publish(rebuild(path, std::move(replacement)));
+    }
+
+    bool contains(const Key& key) const {
+        return snapshot().contains(key);
+    }
+
+    bool isEmpty() const {
+        return snapshot().isEmpty();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(writer);
+        publish(nullptr);
+    }
+};
+
+#endif
@@ -1,73 +1,178 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include "NodePool.h"
 
-struct QNode {
-    std::string data;
-    QNode* next;
-    QNode(std::string val) : data(val), next(nullptr) {}
-};
-
+// FIFO queue of strings in a circular buffer whose capacity is a power of
+// two, so positions wrap with a mask. A full buffer doubles, and the
+// elements are moved to the front of the new one in queue order; push and
+// pop allocate nothing in between. Slots outside [head, head + size) hold
+// no object.
+//
+// The allocator only decides where the buffer comes from: a pool() with a
+// memory_resource takes it from that resource, anything else from
+// operator new (the buffer is its own pool).
 class Queue {
 private:
-    QNode* head;
-    QNode* tail;
+    static const size_t MIN_CAPACITY = 16;
+
+    std::string* buffer;
+    size_t capacity;
+    size_t head;
     size_t size;
+    NodeAllocator source;
+
+    std::string* allocate(size_t n) const {
+        void* memory = source.resource ? source.resource->allocate(n * sizeof(std::string), alignof(std::string))
+                                       : ::operator new(n * sizeof(std::string));
+        return static_cast<std::string*>(memory);
+    }
+
+    void deallocate(std::string* p, size_t n) const {
+        if (!p) return;
+        if (source.resource) source.resource->deallocate(p, n * sizeof(std::string), alignof(std::string));
+        else ::operator delete(p);
+    }
+
+    std::string& at(size_t i) const { return buffer[(head + i) & (capacity - 1)]; }
+
+    // Moves the elements into a buffer of new_capacity, starting at slot 0.
+    // extra, if given, is constructed in the new buffer right after them
+    // before the old elements move, so it may refer to one of them.
+    template <typename... Args>
+    void reallocate(size_t new_capacity, bool extra, Args&&... args) {
+        std::string* fresh = allocate(new_capacity);
+        if (extra) {
+            try {
+                new (&fresh[size]) std::string(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(fresh, new_capacity);
+                throw;
+            }
+        }
+        for (size_t i = 0; i < size; ++i) {
+            new (&fresh[i]) std::string(std::move(at(i)));
+            at(i).~basic_string();
+        }
+        deallocate(buffer, capacity);
+        buffer = fresh;
+        capacity = new_capacity;
+        head = 0;
+    }
+
+    static size_t roundUp(size_t n) {
+        size_t c = MIN_CAPACITY;
+        while (c < n) c *= 2;
+        return c;
+    }
 
 public:
-    Queue() : head(nullptr), tail(nullptr), size(0) {}
+    explicit Queue(const NodeAllocator& alloc = NodeAllocator())
+        : buffer(nullptr), capacity(0), head(0), size(0), source(alloc) {}
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
 
     ~Queue() {
         clear();
     }
 
-    void push(const std::string& value) {
-        QNode* newNode = new QNode(value);
-        if (!tail) {
-            head = tail = newNode;
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (size == capacity) {
+            reallocate(roundUp(capacity + 1), true, std::forward<Args>(args)...);
         } else {
-            tail->next = newNode;
-            tail = newNode;
+            new (&at(size)) std::string(std::forward<Args>(args)...);
         }
         size++;
     }
 
-    std::string pop() {
-        if (!head) return "";
-        std::string val = head->data;
-        QNode* temp = head;
-        head = head->next;
-        if (!head) tail = nullptr;
-        delete temp;
+    void push(const std::string& value) { emplace(value); }
+    void push(std::string&& value) { emplace(std::move(value)); }
+
+    // Appends [first, last) in order; forward ranges grow the buffer once.
+    template <typename It>
+    void push_range(It first, It last) {
+        using Category = typename std::iterator_traits<It>::iterator_category;
+        if (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+            reserve(size + static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) emplace(*first);
+    }
+
+    // Moves the front element into out; false if the queue is empty.
+    bool try_pop(std::string& out) {
+        if (size == 0) return false;
+        std::string& front = at(0);
+        out = std::move(front);
+        front.~basic_string();
+        head = (head + 1) & (capacity - 1);
         size--;
-        return val;
+        return true;
+    }
+
+    // Front element, moved out; "" if the queue is empty (use try_pop to
+    // tell that apart from an empty string).
+    std::string pop() {
+        std::string value;
+        try_pop(value);
+        return value;
+    }
+
+    // Moves up to n front elements to out in order; returns how many.
+    template <typename OutputIt>
+    size_t pop_n(size_t n, OutputIt out) {
+        if (n > size) n = size;
+        for (size_t i = 0; i < n; ++i) {
+            std::string& front = at(0);
+            *out++ = std::move(front);
+            front.~basic_string();
+            head = (head + 1) & (capacity - 1);
+            size--;
+        }
+        return n;
     }
 
     std::string peek() const {
-        if (!head) return "";
-        return head->data;
+        if (size == 0) return "";
+        return at(0);
     }
 
     bool isEmpty() const {
-        return head == nullptr;
+        return size == 0;
+    }
+
+    // Makes room for n elements without further growth.
+    void reserve(size_t n) {
+        if (n > capacity) reallocate(roundUp(n), false);
     }
 
     void print() const {
-        QNode* temp = head;
-        while (temp) {
-            std::cout << temp->data << " ";
-            temp = temp->next;
+        for (size_t i = 0; i < size; ++i) {
+            std::cout << at(i) << " ";
         }
         std::cout << std::endl;
     }
 
+    // Destroys the elements and frees the buffer.
     void clear() {
-        while (head) pop();
+        for (size_t i = 0; i < size; ++i) at(i).~basic_string();
+        deallocate(buffer, capacity);
+        buffer = nullptr;
+        capacity = 0;
+        head = 0;
+        size = 0;
     }
 
     size_t get_size() const { return size; }
+    size_t get_capacity() const { return capacity; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,160 @@
+#ifndef SEGMENTED_ARRAY_H
+#define SEGMENTED_ARRAY_H
+
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Array made of fixed-size chunks of 2^ChunkShift elements reached through
+// a directory of chunk pointers. Growing allocates one more chunk and only
+// the directory (one pointer per chunk) is ever reallocated, so elements
+// never move: pointers and references stay valid until the element is
+// removed, and there is no copy pause or double-capacity peak. Element i
+// lives at chunks[i >> ChunkShift][i & (ChunkSize - 1)].
+template <typename T = std::string, int ChunkShift = 12>
+class SegmentedArray {
+private:
+    static const int ChunkSize = 1 << ChunkShift;
+    static const int ChunkMask = ChunkSize - 1;
+
+    std::vector<T*> chunks;
+    int size;
+
+    T* slot(int index) const {
+        return chunks[index >> ChunkShift] + (index & ChunkMask);
+    }
+
+    void addChunk() {
+        chunks.push_back(static_cast<T*>(::operator new(sizeof(T) * ChunkSize)));
+    }
+
+    void destroyAll() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (int i = 0; i < size; ++i) slot(i)->~T();
+        }
+    }
+
+    void releaseChunks() {
+        for (T* chunk : chunks) ::operator delete(chunk);
+        chunks.clear();
+    }
+
+public:
+    SegmentedArray() : size(0) {}
+
+    SegmentedArray(const SegmentedArray& other) : size(0) {
+        reserve(other.size);
+        for (int i = 0; i < other.size; ++i) push_back(other[i]);
+    }
+
+    SegmentedArray(SegmentedArray&& other) noexcept : chunks(std::move(other.chunks)), size(other.size) {
+        other.chunks.clear();
+        other.size = 0;
+    }
+
+    SegmentedArray& operator=(SegmentedArray other) {
+        chunks.swap(other.chunks);
+        std::swap(size, other.size);
+        return *this;
+    }
+
+    ~SegmentedArray() {
+        destroyAll();
+        releaseChunks();
+    }
+
+    void reserve(int new_capacity) {
+        while (get_capacity() < new_capacity) addChunk();
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        // A new chunk never relocates existing elements, so args may safely
+        // refer to one of them.
+        if (size == get_capacity()) addChunk();
+        T* target = ::new (static_cast<void*>(slot(size))) T(std::forward<Args>(args)...);
+        size++;
+        return *target;
+    }
+
+    void pop_back() {
+        if (size == 0) return;
+        size--;
+        slot(size)->~T();
+    }
+
+    // Shifts the following elements one slot back; O(n) like DynamicArray.
+    void insert(int index, T value) {
+        if (index < 0 || index > size) return;
+        if (index == size) {
+            emplace_back(std::move(value));
+            return;
+        }
+        emplace_back(std::move((*this)[size - 1]));
+        for (int i = size - 2; i > index; --i) (*this)[i] = std::move((*this)[i - 1]);
+        (*this)[index] = std::move(value);
+    }
+
+    void remove_at(int index) {
+        if (index < 0 || index >= size) return;
+        for (int i = index; i + 1 < size; ++i) (*this)[i] = std::move((*this)[i + 1]);
+        pop_back();
+    }
+
+    T get(int index) const {
+        if (index < 0 || index >= size) return T();
+        return *slot(index);
+    }
+
+    // Unchecked access without the copy made by get().
+    T& operator[](int index) { return *slot(index); }
+    const T& operator[](int index) const { return *slot(index); }
+
+    void set(int index, const T& value) {
+        if (index < 0 || index >= size) return;
+        *slot(index) = value;
+    }
+
+    void set(int index, T&& value) {
+        if (index < 0 || index >= size) return;
+        *slot(index) = std::move(value);
+    }
+
+    void print() const {
+        for (int i = 0; i < size; ++i) {
+            std::cout << *slot(i) << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Destroys the elements but keeps the allocated chunks.
+    void clear() {
+        destroyAll();
+        size = 0;
+    }
+
+    // Frees the chunks past the one holding the last element.
+    void shrink_to_fit() {
+        size_t used = (static_cast<size_t>(size) + ChunkMask) >> ChunkShift;
+        for (size_t i = used; i < chunks.size(); ++i) ::operator delete(chunks[i]);
+        chunks.resize(used);
+        chunks.shrink_to_fit();
+    }
+
+    int get_size() const { return size; }
+    int get_capacity() const { return static_cast<int>(chunks.size()) << ChunkShift; }
+    static int get_chunk_size() { return ChunkSize; }
+};
+
+#endif
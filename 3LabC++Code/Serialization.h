@@ -1,12 +1,21 @@
 #ifndef SERIALIZATION_H
 #define SERIALIZATION_H
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 #include "DynamicArray.h"
+#include "StringPoolArray.h"
 #include "SinglyList.h"
 #include "DoublyList.h"
+#include "CompactList.h"
 #include "HashTable.h"
 #include "HashTableOpen.h"
 #include "BinarySearchTree.h"
@@ -16,7 +25,7 @@
 // DYNAMIC ARRAY SERIALIZATION
 
 // Текстовый формат
-inline void saveToText(const DynamicArray& arr, const std::string& filename) {
+inline void saveToText(const DynamicArray<std::string>& arr, const std::string& filename) {
     std::ofstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
@@ -28,7 +37,7 @@ inline void saveToText(const DynamicArray& arr, const std::string& filename) {
     file.close();
 }
 
-inline void loadFromText(DynamicArray& arr, const std::string& filename) {
+inline void loadFromText(DynamicArray<std::string>& arr, const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
@@ -46,7 +55,7 @@ inline void loadFromText(DynamicArray& arr, const std::string& filename) {
 }
 
 // Бинарный формат
-inline void saveToBinary(const DynamicArray& arr, const std::string& filename) {
+inline void saveToBinary(const DynamicArray<std::string>& arr, const std::string& filename) {
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
@@ -54,7 +63,7 @@ inline void saveToBinary(const DynamicArray& arr, const std::string& filename) {
     file.write(reinterpret_cast<const char*>(&size), sizeof(size));
     
     for (int i = 0; i < size; ++i) {
-        std::string str = arr.get(i);
+        const std::string& str = arr[i];
         int len = str.length();
         file.write(reinterpret_cast<const char*>(&len), sizeof(len));
         file.write(str.c_str(), len);
@@ -62,7 +71,7 @@ inline void saveToBinary(const DynamicArray& arr, const std::string& filename) {
     file.close();
 }
 
-inline void loadFromBinary(DynamicArray& arr, const std::string& filename) {
+inline void loadFromBinary(DynamicArray<std::string>& arr, const std::string& filename) {
     std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
@@ -75,7 +84,84 @@ inline void loadFromBinary(DynamicArray& arr, const std::string& filename) {
         file.read(reinterpret_cast<char*>(&len), sizeof(len));
         std::string str(len, '\0');
         file.read(&str[0], len);
-        arr.push_back(str);
+        arr.push_back(std::move(str));
+    }
+    file.close();
+}
+
+// STRING POOL ARRAY SERIALIZATION
+// Тот же формат, что и у DynamicArray
+
+// Текстовый формат
+inline void saveToText(const StringPoolArray& arr, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+    
+    int size = arr.get_size();
+    file << size << "\n";
+    for (int i = 0; i < size; ++i) {
+        file << arr.get(i) << "\n";
+    }
+    file.close();
+}
+
+inline void loadFromText(StringPoolArray& arr, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+    
+    arr.clear();
+    int size;
+    file >> size;
+    file.ignore();
+    
+    std::string line;
+    for (int i = 0; i < size; ++i) {
+        std::getline(file, line);
+        arr.push_back(line);
+    }
+    file.close();
+}
+
+// Бинарный формат
+inline void saveToBinary(const StringPoolArray& arr, const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+    
+    int size = arr.get_size();
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    
+    for (int i = 0; i < size; ++i) {
+        std::string_view str = arr.get(i);
+        int len = str.length();
+        file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        file.write(str.data(), len);
+    }
+    file.close();
+}
+
+// Весь файл читается одним вызовом, строки копируются прямо в общий буфер
+inline void loadFromBinary(StringPoolArray& arr, const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+    
+    arr.clear();
+    std::streamsize total = file.tellg();
+    file.seekg(0);
+    int size = 0;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    
+    std::vector<char> payload(total > (std::streamsize)sizeof(size) ? total - sizeof(size) : 0);
+    file.read(payload.data(), payload.size());
+    arr.reserve(size, payload.size() - std::min(payload.size(), size * sizeof(int)));
+    
+    size_t pos = 0;
+    for (int i = 0; i < size && pos + sizeof(int) <= payload.size(); ++i) {
+        int len;
+        std::memcpy(&len, payload.data() + pos, sizeof(len));
+        pos += sizeof(len);
+        if (len < 0 || pos + len > payload.size()) break;
+        arr.push_back(std::string_view(payload.data() + pos, len));
+        pos += len;
     }
     file.close();
 }
@@ -163,15 +249,9 @@ inline void saveToText(const DoublyLinkedList& list, const std::string& filename
     std::ofstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
-    LNode* temp = list.getHead();
-    int count = 0;
-    LNode* counter = temp;
-    while (counter) { count++; counter = counter->next; }
-    
-    file << count << "\n";
-    while (temp) {
-        file << temp->data << "\n";
-        temp = temp->next;
+    file << list.get_size() << "\n";
+    for (const std::string& value : list) {
+        file << value << "\n";
     }
     file.close();
 }
@@ -198,18 +278,13 @@ inline void saveToBinary(const DoublyLinkedList& list, const std::string& filena
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     
-    LNode* temp = list.getHead();
-    int count = 0;
-    LNode* counter = temp;
-    while (counter) { count++; counter = counter->next; }
-    
+    int count = static_cast<int>(list.get_size());
     file.write(reinterpret_cast<const char*>(&count), sizeof(count));
     
-    while (temp) {
-        int len = temp->data.length();
+    for (const std::string& value : list) {
+        int len = value.length();
         file.write(reinterpret_cast<const char*>(&len), sizeof(len));
-        file.write(temp->data.c_str(), len);
-        temp = temp->next;
+        file.write(value.c_str(), len);
     }
     file.close();
 }
@@ -232,6 +307,74 @@ inline void loadFromBinary(DoublyLinkedList& list, const std::string& filename)
     file.close();
 }
 
+// COMPACT DOUBLY LIST SERIALIZATION
+// Формат совпадает с DoublyLinkedList, так что файлы взаимозаменяемы
+
+// Текстовый формат
+inline void saveToText(const CompactDoublyList& list, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    file << list.get_size() << "\n";
+    for (const std::string& value : list) {
+        file << value << "\n";
+    }
+    file.close();
+}
+
+inline void loadFromText(CompactDoublyList& list, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    list.clear();
+    int size;
+    file >> size;
+    file.ignore();
+    if (size > 0) list.reserve(size);
+
+    std::string line;
+    for (int i = 0; i < size; ++i) {
+        std::getline(file, line);
+        list.push_back(line);
+    }
+    file.close();
+}
+
+// Бинарный формат
+inline void saveToBinary(const CompactDoublyList& list, const std::string& filename) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    int count = static_cast<int>(list.get_size());
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (const std::string& value : list) {
+        int len = value.length();
+        file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        file.write(value.c_str(), len);
+    }
+    file.close();
+}
+
+inline void loadFromBinary(CompactDoublyList& list, const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    list.clear();
+    int size;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (size > 0) list.reserve(size);
+
+    for (int i = 0; i < size; ++i) {
+        int len;
+        file.read(reinterpret_cast<char*>(&len), sizeof(len));
+        std::string str(len, '\0');
+        file.read(&str[0], len);
+        list.push_back(str);
+    }
+    file.close();
+}
+
 // STACK SERIALIZATION
 
 // Текстовый формат
@@ -599,83 +742,213 @@ inline void loadFromBinary(HashTableOpen& ht, const std::string& filename) {
 
 // BINARY SEARCH TREE SERIALIZATION
 
+// Поля узла: числа пишутся как есть (пустой узел - минимальное значение типа,
+// для int это прежний маркер -2147483648), строки - с префиксом длины
+// (пустой узел - длина -1). В тексте строковые ключи начинаются с ':',
+// чтобы ключ "#" не совпадал с маркером пустого узла.
 namespace BSTSerializer {
-    inline void saveNodeText(std::ofstream& file, TreeNode* node) {
-        if (node == nullptr) {
-            file << "#\n";
-            return;
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    writeTextKey(std::ofstream& file, const T& key) {
+        file << key << "\n";
+    }
+
+    inline void writeTextKey(std::ofstream& file, const std::string& key) {
+        file << ':' << key << "\n";
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    readTextKey(const std::string& line, T& key) {
+        std::istringstream(line) >> key;
+    }
+
+    inline void readTextKey(const std::string& line, std::string& key) {
+        key = line.substr(1);
+    }
+
+    template <typename T>
+    void writeTextValue(std::ofstream& file, const T& value) {
+        file << value << "\n";
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    readTextValue(std::ifstream& file, T& value) {
+        std::string line;
+        std::getline(file, line);
+        std::istringstream(line) >> value;
+    }
+
+    inline void readTextValue(std::ifstream& file, std::string& value) {
+        std::getline(file, value);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    writeBinaryField(std::ofstream& file, const T& field) {
+        file.write(reinterpret_cast<const char*>(&field), sizeof(field));
+    }
+
+    inline void writeBinaryField(std::ofstream& file, const std::string& field) {
+        int len = field.length();
+        file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        file.write(field.c_str(), len);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    writeBinaryNull(std::ofstream& file, const T*) {
+        T marker = std::numeric_limits<T>::lowest();
+        file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+    }
+
+    inline void writeBinaryNull(std::ofstream& file, const std::string*) {
+        int len = -1;
+        file.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    }
+
+    // false, если прочитан маркер пустого узла или файл закончился
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, bool>::type
+    readBinaryField(std::ifstream& file, T& field) {
+        return file.read(reinterpret_cast<char*>(&field), sizeof(field))
+            && field != std::numeric_limits<T>::lowest();
+    }
+
+    inline bool readBinaryField(std::ifstream& file, std::string& field) {
+        int len;
+        if (!file.read(reinterpret_cast<char*>(&len), sizeof(len)) || len < 0) {
+            return false;
+        }
+        field.assign(len, '\0');
+        file.read(&field[0], len);
+        return true;
+    }
+
+    // Обход в прямом порядке с явным стеком: глубина дерева не ограничена стеком вызовов
+    template <typename Key, typename Value>
+    void saveNodeText(std::ofstream& file, TreeNode<Key, Value>* node) {
+        std::vector<TreeNode<Key, Value>*> stack;
+        stack.push_back(node);
+        while (!stack.empty()) {
+            node = stack.back();
+            stack.pop_back();
+            if (node == nullptr) {
+                file << "#\n";
+                continue;
+            }
+            writeTextKey(file, node->key);
+            if constexpr (!std::is_void<Value>::value) {
+                writeTextValue(file, node->value);
+            }
+            stack.push_back(node->right);
+            stack.push_back(node->left);
         }
-        file << node->key << "\n";
-        saveNodeText(file, node->left);
-        saveNodeText(file, node->right);
     }
     
-    inline TreeNode* loadNodeText(std::ifstream& file) {
+    template <typename Key, typename Value>
+    TreeNode<Key, Value>* loadNodeText(std::ifstream& file) {
+        TreeNode<Key, Value>* root = nullptr;
+        std::vector<TreeNode<Key, Value>**> links;
+        links.push_back(&root);
         std::string line;
-        if (!std::getline(file, line) || line == "#") {
-            return nullptr;
+        while (!links.empty()) {
+            TreeNode<Key, Value>** link = links.back();
+            links.pop_back();
+            if (!std::getline(file, line) || line == "#") {
+                continue;
+            }
+            Key key;
+            readTextKey(line, key);
+            TreeNode<Key, Value>* node = new TreeNode<Key, Value>(key);
+            if constexpr (!std::is_void<Value>::value) {
+                readTextValue(file, node->value);
+            }
+            *link = node;
+            links.push_back(&node->right);
+            links.push_back(&node->left);
         }
-        int key = std::stoi(line);
-        TreeNode* node = new TreeNode(key);
-        node->left = loadNodeText(file);
-        node->right = loadNodeText(file);
-        return node;
-    }
-    
-    inline void saveNodeBinary(std::ofstream& file, TreeNode* node) {
-        if (node == nullptr) {
-            int marker = -2147483648;
-            file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
-            return;
+        return root;
+    }
+    
+    template <typename Key, typename Value>
+    void saveNodeBinary(std::ofstream& file, TreeNode<Key, Value>* node) {
+        std::vector<TreeNode<Key, Value>*> stack;
+        stack.push_back(node);
+        while (!stack.empty()) {
+            node = stack.back();
+            stack.pop_back();
+            if (node == nullptr) {
+                writeBinaryNull(file, static_cast<const Key*>(nullptr));
+                continue;
+            }
+            writeBinaryField(file, node->key);
+            if constexpr (!std::is_void<Value>::value) {
+                writeBinaryField(file, node->value);
+            }
+            stack.push_back(node->right);
+            stack.push_back(node->left);
         }
-        int key = node->key;
-        file.write(reinterpret_cast<const char*>(&key), sizeof(key));
-        saveNodeBinary(file, node->left);
-        saveNodeBinary(file, node->right);
     }
     
-    inline TreeNode* loadNodeBinary(std::ifstream& file) {
-        int key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        if (key == -2147483648) {
-            return nullptr;
+    template <typename Key, typename Value>
+    TreeNode<Key, Value>* loadNodeBinary(std::ifstream& file) {
+        TreeNode<Key, Value>* root = nullptr;
+        std::vector<TreeNode<Key, Value>**> links;
+        links.push_back(&root);
+        while (!links.empty()) {
+            TreeNode<Key, Value>** link = links.back();
+            links.pop_back();
+            Key key;
+            if (!readBinaryField(file, key)) {
+                continue;
+            }
+            TreeNode<Key, Value>* node = new TreeNode<Key, Value>(key);
+            if constexpr (!std::is_void<Value>::value) {
+                readBinaryField(file, node->value);
+            }
+            *link = node;
+            links.push_back(&node->right);
+            links.push_back(&node->left);
         }
-        TreeNode* node = new TreeNode(key);
-        node->left = loadNodeBinary(file);
-        node->right = loadNodeBinary(file);
-        return node;
+        return root;
     }
 }
 
 // Текстовый формат
-inline void saveToText(const BinarySearchTree& bst, const std::string& filename) {
+template <typename Key, typename Value, typename Compare>
+void saveToText(const BinarySearchTree<Key, Value, Compare>& bst, const std::string& filename) {
     std::ofstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     BSTSerializer::saveNodeText(file, bst.getRoot());
     file.close();
 }
 
-inline void loadFromText(BinarySearchTree& bst, const std::string& filename) {
+template <typename Key, typename Value, typename Compare>
+void loadFromText(BinarySearchTree<Key, Value, Compare>& bst, const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     bst.clear();
-    bst.setRoot(BSTSerializer::loadNodeText(file));
+    bst.setRoot(BSTSerializer::loadNodeText<Key, Value>(file));
     file.close();
 }
 
 // Бинарный формат
-inline void saveToBinary(const BinarySearchTree& bst, const std::string& filename) {
+template <typename Key, typename Value, typename Compare>
+void saveToBinary(const BinarySearchTree<Key, Value, Compare>& bst, const std::string& filename) {
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     BSTSerializer::saveNodeBinary(file, bst.getRoot());
     file.close();
 }
 
-inline void loadFromBinary(BinarySearchTree& bst, const std::string& filename) {
+template <typename Key, typename Value, typename Compare>
+void loadFromBinary(BinarySearchTree<Key, Value, Compare>& bst, const std::string& filename) {
     std::ifstream file(filename, std::ios::binary);
     if (!file.is_open()) throw std::runtime_error("Cannot open file: " + filename);
     bst.clear();
-    bst.setRoot(BSTSerializer::loadNodeBinary(file));
+    bst.setRoot(BSTSerializer::loadNodeBinary<Key, Value>(file));
     file.close();
 }
 
@@ -0,0 +1,172 @@
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Bulk equality kernels shared by the array containers. Integer elements
+// of 1, 2, 4 or 8 bytes are compared a whole register at a time (AVX2,
+// else SSE2, else scalar); other element types use the scalar loops.
+
+template <typename T>
+struct SimdScannable
+    : std::integral_constant<bool, std::is_integral<T>::value &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+#ifdef __AVX2__
+template <size_t Size> inline __m256i simdBroadcast(const void* value);
+template <> inline __m256i simdBroadcast<1>(const void* v) { return _mm256_set1_epi8(*static_cast<const char*>(v)); }
+template <> inline __m256i simdBroadcast<2>(const void* v) { return _mm256_set1_epi16(*static_cast<const short*>(v)); }
+template <> inline __m256i simdBroadcast<4>(const void* v) { return _mm256_set1_epi32(*static_cast<const int*>(v)); }
+template <> inline __m256i simdBroadcast<8>(const void* v) { return _mm256_set1_epi64x(*static_cast<const long long*>(v)); }
+
+template <size_t Size> inline __m256i simdCompareEq(__m256i a, __m256i b);
+template <> inline __m256i simdCompareEq<1>(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+template <> inline __m256i simdCompareEq<2>(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+template <> inline __m256i simdCompareEq<4>(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+template <> inline __m256i simdCompareEq<8>(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+
+// Byte mask of the lanes of data[i..i+32/sizeof(T)) equal to needle.
+template <typename T>
+inline unsigned simdEqualMask(const T* data, __m256i needle) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    return static_cast<unsigned>(_mm256_movemask_epi8(simdCompareEq<sizeof(T)>(chunk, needle)));
+}
+static const int SIMD_SCAN_BYTES = 32;
+#elif defined(__SSE2__)
+template <size_t Size> inline __m128i simdBroadcast(const void* value);
+template <> inline __m128i simdBroadcast<1>(const void* v) { return _mm_set1_epi8(*static_cast<const char*>(v)); }
+template <> inline __m128i simdBroadcast<2>(const void* v) { return _mm_set1_epi16(*static_cast<const short*>(v)); }
+template <> inline __m128i simdBroadcast<4>(const void* v) { return _mm_set1_epi32(*static_cast<const int*>(v)); }
+template <> inline __m128i simdBroadcast<8>(const void* v) { return _mm_set1_epi64x(*static_cast<const long long*>(v)); }
+
+template <size_t Size> inline __m128i simdCompareEq(__m128i a, __m128i b);
+template <> inline __m128i simdCompareEq<1>(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+template <> inline __m128i simdCompareEq<2>(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+template <> inline __m128i simdCompareEq<4>(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+template <> inline __m128i simdCompareEq<8>(__m128i a, __m128i b) {
+    // SSE2 has no 64-bit compare: both 32-bit halves must match.
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template <typename T>
+inline unsigned simdEqualMask(const T* data, __m128i needle) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    return static_cast<unsigned>(_mm_movemask_epi8(simdCompareEq<sizeof(T)>(chunk, needle)));
+}
+static const int SIMD_SCAN_BYTES = 16;
+#endif
+
+// Index of the first element equal to value, or -1.
+template <typename T>
+int simdFind(const T* data, int n, const T& value) {
+    int i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (SimdScannable<T>::value) {
+        const int lanes = SIMD_SCAN_BYTES / sizeof(T);
+        auto needle = simdBroadcast<sizeof(T)>(&value);
+        for (; i + lanes <= n; i += lanes) {
+            unsigned mask = simdEqualMask(data + i, needle);
+            if (mask) return i + __builtin_ctz(mask) / static_cast<int>(sizeof(T));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (data[i] == value) return i;
+    }
+    return -1;
+}
+
+template <typename T>
+int simdCount(const T* data, int n, const T& value) {
+    int i = 0;
+    int found = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (SimdScannable<T>::value) {
+        const int lanes = SIMD_SCAN_BYTES / sizeof(T);
+        auto needle = simdBroadcast<sizeof(T)>(&value);
+        size_t matchedBytes = 0;
+        for (; i + lanes <= n; i += lanes) {
+            matchedBytes += __builtin_popcount(simdEqualMask(data + i, needle));
+        }
+        found = static_cast<int>(matchedBytes / sizeof(T));
+    }
+#endif
+    for (; i < n; ++i) found += data[i] == value;
+    return found;
+}
+
+// True if any element equals any of the k values. Each register of data is
+// tested against every value before moving on, so data is read once.
+template <typename T>
+bool simdContainsAny(const T* data, int n, const T* values, int k) {
+    if (k <= 0) return false;
+    int i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (SimdScannable<T>::value) {
+        if (k <= 8) {
+            const int lanes = SIMD_SCAN_BYTES / sizeof(T);
+            decltype(simdBroadcast<sizeof(T)>(values)) needles[8];
+            for (int j = 0; j < k; ++j) needles[j] = simdBroadcast<sizeof(T)>(values + j);
+            for (; i + lanes <= n; i += lanes) {
+                unsigned mask = 0;
+                for (int j = 0; j < k; ++j) mask |= simdEqualMask(data + i, needles[j]);
+                if (mask) return true;
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        for (int j = 0; j < k; ++j) {
+            if (data[i] == values[j]) return true;
+        }
+    }
+    return false;
+}
+
+// memcmp(a, b, n) == 0, a register of bytes at a time.
+inline bool simdBytesEqual(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+#ifdef __AVX2__
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y))) != 0xFFFFFFFFu) return false;
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF) return false;
+    }
+#endif
+    return std::memcmp(a + i, b + i, n - i) == 0;
+}
+
+// String equality with the length compared before any byte.
+inline bool simdStringEqual(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && simdBytesEqual(a.data(), b.data(), a.size());
+}
+
+inline bool simdStartsWith(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() && simdBytesEqual(s.data(), prefix.data(), prefix.size());
+}
+
+// Bit (len & 63) set for every needle length: one AND rejects most
+// candidates before any byte comparison.
+template <typename Strings>
+unsigned long long lengthFilter(const Strings& values, int k) {
+    unsigned long long filter = 0;
+    for (int j = 0; j < k; ++j) filter |= 1ULL << (values[j].size() & 63);
+    return filter;
+}
+
+#endif
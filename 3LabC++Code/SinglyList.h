@@ -2,29 +2,113 @@
 #define SINGLYLIST_H
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ListFindMany.h"
+#include "ListIndex.h"
+#include "ListSort.h"
+#include "NodePool.h"
 
 struct FNode {
     std::string key;
     FNode* next;
-    FNode(std::string k, FNode* n = nullptr) : key(k), next(n) {}
+    FNode(std::string k, FNode* n = nullptr) : key(std::move(k)), next(n) {}
 };
 
 class SinglyLinkedList {
 private:
     FNode* head;
+    FNode* tail;
     size_t size;
+    NodeArena<FNode> nodes;
+    std::unique_ptr<ListIndex<FNode, &FNode::key>> index;
+    // Node -> the node before it (nullptr for the head), kept only while
+    // the index is on so the edits that need a predecessor skip the walk.
+    std::unordered_map<const FNode*, FNode*> predecessors;
+
+    void unindex(FNode* node) {
+        if (!index) return;
+        index->removed(node, head);
+        predecessors.erase(node);
+    }
+
+    // Records that node now follows prev.
+    void linked(FNode* prev, FNode* node) {
+        if (index && node) predecessors[node] = prev;
+    }
+
+    FNode* before(const FNode* node) const { return predecessors.find(node)->second; }
+
+    // Indexes the chain starting at node, which follows prev.
+    void indexChain(FNode* node, FNode* prev) {
+        if (!index) return;
+        for (; node; prev = node, node = node->next) {
+            index->added(node, ListPosition::Back);
+            predecessors[node] = prev;
+        }
+    }
+
+    void reindex() {
+        if (!index) return;
+        dropIndexEntries();
+        indexChain(head, nullptr);
+    }
+
+    // Empties the index without turning it off.
+    void dropIndexEntries() {
+        if (!index) return;
+        index->clear();
+        predecessors.clear();
+    }
+
+    // First node holding value and the two nodes before it (nullptr where
+    // there are none); O(1) expected with the index.
+    FNode* locate(const std::string& value, FNode*& prev, FNode*& prevPrev) const {
+        prev = prevPrev = nullptr;
+        if (index) {
+            FNode* target = index->first(value, head);
+            if (!target) return nullptr;
+            prev = before(target);
+            if (prev) prevPrev = before(prev);
+            return target;
+        }
+        for (FNode* node = head; node; node = node->next) {
+            if (node->key == value) return node;
+            prevPrev = prev;
+            prev = node;
+        }
+        return nullptr;
+    }
+
+    // Unlinks and destroys node, which follows prev (nullptr for the head).
+    void unlinkAfter(FNode* prev, FNode* node) {
+        unindex(node);
+        linked(prev, node->next);
+        if (prev) prev->next = node->next;
+        else head = node->next;
+        if (node == tail) tail = prev;
+        nodes.destroy(node);
+        size--;
+    }
 
 public:
-    SinglyLinkedList() : head(nullptr), size(0) {}
+    explicit SinglyLinkedList(const NodeAllocator& alloc = NodeAllocator()) : head(nullptr), tail(nullptr), size(0), nodes(alloc) {}
 
     ~SinglyLinkedList() {
         clear();
     }
 
     void push_front(const std::string& key) {
-        head = new FNode(key, head);
+        head = nodes.create(key, head);
+        if (!tail) tail = head;
         size++;
+        if (index) index->added(head, ListPosition::Front);
+        linked(nullptr, head);
+        linked(head, head->next);
     }
 
     void push_back(const std::string& key) {
@@ -32,39 +116,167 @@ public:
             push_front(key);
             return;
         }
-        FNode* temp = head;
-        while (temp->next) temp = temp->next;
-        temp->next = new FNode(key);
+        tail->next = nodes.create(key);
+        linked(tail, tail->next);
+        tail = tail->next;
         size++;
+        if (index) index->added(tail, ListPosition::Back);
     }
 
-    void pop_front() {
-        if (!head) return;
-        FNode* temp = head;
-        head = head->next;
-        delete temp;
-        size--;
+    // Builds the chain for [first, last) off to the side and links it in
+    // one step.
+    template <typename InputIt>
+    void append_range(InputIt first, InputIt last) {
+        FNode* chainHead = nullptr;
+        FNode* chainTail = nullptr;
+        size_t count = 0;
+        try {
+            for (; first != last; ++first) {
+                FNode* node = nodes.create(*first);
+                if (chainTail) chainTail->next = node;
+                else chainHead = node;
+                chainTail = node;
+                count++;
+            }
+        } catch (...) {
+            while (chainHead) {
+                FNode* next = chainHead->next;
+                nodes.destroy(chainHead);
+                chainHead = next;
+            }
+            throw;
+        }
+        if (!chainHead) return;
+        FNode* oldTail = tail;
+        if (tail) tail->next = chainHead;
+        else head = chainHead;
+        tail = chainTail;
+        size += count;
+        indexChain(chainHead, oldTail);
     }
 
-    void remove_value(const std::string& value) {
-        if (!head) return;
-        if (head->key == value) {
-            pop_front();
+    // Moves all nodes of other to the end of this list, leaving other
+    // empty. O(1) relinking when the node storage is compatible, otherwise
+    // the values are moved into new nodes.
+    void splice(SinglyLinkedList& other) {
+        if (this == &other || !other.head) return;
+        if (nodes.canAdopt(other.nodes)) {
+            nodes.adopt(other.nodes);
+            other.dropIndexEntries();
+            indexChain(other.head, tail);
+            if (tail) tail->next = other.head;
+            else head = other.head;
+            tail = other.tail;
+            size += other.size;
+            other.head = other.tail = nullptr;
+            other.size = 0;
             return;
         }
-        FNode* current = head;
-        while (current->next && current->next->key != value) {
-            current = current->next;
+        other.dropIndexEntries();
+        FNode* oldTail = tail;
+        FNode* first = nullptr;
+        for (FNode* node = other.head; node; node = node->next) {
+            FNode* moved = nodes.create(std::move(node->key));
+            if (tail) tail->next = moved;
+            else head = moved;
+            tail = moved;
+            if (!first) first = moved;
+            size++;
+        }
+        other.clear();
+        indexChain(first, oldTail);
+    }
+
+    // Stable O(n log n) bottom-up merge sort; relinks the nodes, the
+    // strings stay where they are.
+    void sort() {
+        head = sortChain<FNode, &FNode::key>(head);
+        tail = head;
+        while (tail && tail->next) tail = tail->next;
+        reindex();
+    }
+
+    // Removes consecutive equal values (every duplicate, once sorted) and
+    // returns the new size.
+    size_t unique() {
+        for (FNode* node = head; node && node->next;) {
+            if (node->next->key == node->key) unlinkAfter(node, node->next);
+            else node = node->next;
+        }
+        return size;
+    }
+
+    // Merges the sorted list other into this sorted list in one pass,
+    // leaving other empty. Equal values keep this list's first. other's
+    // nodes are relinked when the storage allows it (see splice), else
+    // their values are moved into new nodes first.
+    void merge(SinglyLinkedList& other) {
+        if (this == &other || !other.head) return;
+        if (!nodes.canAdopt(other.nodes)) {
+            SinglyLinkedList moved(nodes.get_allocator());
+            for (FNode* node = other.head; node; node = node->next) {
+                FNode* created = moved.nodes.create(std::move(node->key));
+                if (moved.tail) moved.tail->next = created;
+                else moved.head = created;
+                moved.tail = created;
+                moved.size++;
+            }
+            other.clear();
+            merge(moved);
+            return;
         }
-        if (current->next) {
-            FNode* toDelete = current->next;
-            current->next = toDelete->next;
-            delete toDelete;
-            size--;
+        nodes.adopt(other.nodes);
+        other.dropIndexEntries();
+        FNode* otherTail = other.tail;
+        head = mergeChains<FNode, &FNode::key>(head, other.head);
+        if (!tail || !(otherTail->key < tail->key)) tail = otherTail;
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+        reindex();
+    }
+
+    // Removes every value for which pred(value) is true in one pass and
+    // returns how many were removed.
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        // The index is rebuilt once instead of being updated per node.
+        dropIndexEntries();
+        size_t removed = 0;
+        try {
+            FNode* prev = nullptr;
+            for (FNode* node = head; node;) {
+                FNode* next = node->next;
+                if (pred(node->key)) {
+                    unlinkAfter(prev, node);
+                    removed++;
+                } else {
+                    prev = node;
+                }
+                node = next;
+            }
+        } catch (...) {
+            reindex();
+            throw;
         }
+        reindex();
+        return removed;
+    }
+
+    void pop_front() {
+        if (!head) return;
+        unlinkAfter(nullptr, head);
+    }
+
+    void remove_value(const std::string& value) {
+        FNode* prev;
+        FNode* prevPrev;
+        FNode* node = locate(value, prev, prevPrev);
+        if (node) unlinkAfter(prev, node);
     }
 
     FNode* find(const std::string& value) const {
+        if (index) return index->first(value, head);
         FNode* temp = head;
         while (temp) {
             if (temp->key == value) return temp;
@@ -73,76 +285,78 @@ public:
         return nullptr;
     }
 
+    // find() for many values in one traversal: result[i] is the first node
+    // equal to values[i], or nullptr. Costs one walk of the list (up to the
+    // last first match) instead of one per value; with the index each
+    // value is an O(1) lookup instead.
+    std::vector<FNode*> find_many(const std::string_view* values, size_t count) const {
+        std::vector<FNode*> result(count, nullptr);
+        if (index) {
+            for (size_t i = 0; i < count; ++i) result[i] = index->first(values[i], head);
+        } else {
+            findManyInChain<FNode, &FNode::key>(head, values, count, result.data());
+        }
+        return result;
+    }
+
+    std::vector<FNode*> find_many(const std::vector<std::string_view>& values) const {
+        return find_many(values.data(), values.size());
+    }
+
     void pop_back() {
         if (!head) return;
-        if (!head->next) {
-            delete head;
-            head = nullptr;
-            size--;
-            return;
+        FNode* prev = nullptr;
+        if (index) {
+            prev = before(tail);
+        } else if (head->next) {
+            prev = head;
+            while (prev->next->next)
+                prev = prev->next;
         }
-        FNode* temp = head;
-        while (temp->next->next)
-            temp = temp->next;
-        delete temp->next;
-        temp->next = nullptr;
-        size--;
+        unlinkAfter(prev, tail);
     }
 
     bool insert_after(const std::string& target, const std::string& key) {
         FNode* node = find(target);
         if (!node) return false;
-        node->next = new FNode(key, node->next);
+        node->next = nodes.create(key, node->next);
+        if (node == tail) tail = node->next;
         size++;
+        if (index) index->added(node->next, node->next == tail ? ListPosition::Back : ListPosition::Middle);
+        linked(node, node->next);
+        linked(node->next, node->next->next);
         return true;
     }
 
     bool insert_before(const std::string& target, const std::string& key) {
-        if (!head) return false;
-        if (head->key == target) {
+        FNode* prev;
+        FNode* prevPrev;
+        FNode* curr = locate(target, prev, prevPrev);
+        if (!curr) return false;
+        if (!prev) {
             push_front(key);
             return true;
         }
-        FNode* prev = head;
-        FNode* curr = head->next;
-        while (curr && curr->key != target) {
-            prev = curr;
-            curr = curr->next;
-        }
-        if (!curr) return false;
-        prev->next = new FNode(key, curr);
+        prev->next = nodes.create(key, curr);
         size++;
+        if (index) index->added(prev->next, ListPosition::Middle);
+        linked(prev, prev->next);
+        linked(prev->next, curr);
         return true;
     }
 
     bool delete_after(const std::string& target) {
         FNode* node = find(target);
         if (!node || !node->next) return false;
-        FNode* toDelete = node->next;
-        node->next = toDelete->next;
-        delete toDelete;
-        size--;
+        unlinkAfter(node, node->next);
         return true;
     }
 
     bool delete_before(const std::string& target) {
-        if (!head || head->key == target) return false;
-        FNode* prevPrev = nullptr;
-        FNode* prev = head;
-        FNode* curr = head->next;
-        while (curr && curr->key != target) {
-            prevPrev = prev;
-            prev = curr;
-            curr = curr->next;
-        }
-        if (!curr) return false;
-        if (!prevPrev) {
-            pop_front();
-        } else {
-            prevPrev->next = curr;
-            delete prev;
-            size--;
-        }
+        FNode* prev;
+        FNode* prevPrev;
+        if (!locate(target, prev, prevPrev) || !prev) return false;
+        unlinkAfter(prevPrev, prev);
         return true;
     }
 
@@ -165,12 +379,44 @@ public:
     }
 
     void clear() {
-        while (head) pop_front();
+        dropIndexEntries();
+        while (head) {
+            FNode* next = head->next;
+            nodes.dispose(head);
+            head = next;
+        }
+        nodes.release();
+        tail = nullptr;
+        size = 0;
+    }
+
+    // Keeps a value -> first node hash index and a node -> predecessor map
+    // from now on: find, the value-based inserts and deletes, remove_value
+    // and pop_back become O(1) expected. Costs about index_memory() bytes;
+    // values must not be changed through node pointers meanwhile.
+    void enable_index() {
+        if (index) return;
+        index.reset(new ListIndex<FNode, &FNode::key>());
+        indexChain(head, nullptr);
+    }
+
+    void disable_index() {
+        index.reset();
+        std::unordered_map<const FNode*, FNode*>().swap(predecessors);
+    }
+
+    bool has_index() const { return index != nullptr; }
+
+    size_t index_memory() const {
+        if (!index) return 0;
+        size_t perNode = sizeof(std::pair<const FNode* const, FNode*>) + sizeof(void*) + 16;
+        return index->memory_usage() + predecessors.bucket_count() * sizeof(void*) + predecessors.size() * perNode;
     }
 
     bool isEmpty() const { return head == nullptr; }
 
     FNode* getHead() const { return head; }
+    FNode* getTail() const { return tail; }
     size_t get_size() const { return size; }
 };
 
@@ -0,0 +1,510 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include "NodePool.h"
+
+static const int SKIP_MAX_HEIGHT = 32;
+
+// Node of a skip list: the key and a tower of height next pointers, stored
+// right behind the node in the same allocation. Links are atomic so the
+// concurrent set can share the layout; the single-threaded one uses relaxed
+// accesses, which are plain loads and stores.
+struct SkipNode {
+    std::string key;
+    int height;
+    std::atomic<bool> deleted;   // ConcurrentSkipListSet only
+
+    SkipNode(std::string k, int h) : key(std::move(k)), height(h), deleted(false) {}
+
+    std::atomic<SkipNode*>* links() { return reinterpret_cast<std::atomic<SkipNode*>*>(this + 1); }
+
+    SkipNode* next(int level, std::memory_order order = std::memory_order_relaxed) {
+        return links()[level].load(order);
+    }
+
+    static size_t bytesFor(int height) {
+        return sizeof(SkipNode) + height * sizeof(std::atomic<SkipNode*>);
+    }
+
+    static SkipNode* construct(void* memory, std::string key, int height) {
+        SkipNode* node = new (memory) SkipNode(std::move(key), height);
+        for (int i = 0; i < height; ++i) new (&node->links()[i]) std::atomic<SkipNode*>(nullptr);
+        return node;
+    }
+};
+
+static_assert(sizeof(SkipNode) % alignof(std::atomic<SkipNode*>) == 0, "tower must follow the node aligned");
+
+// Geometric tower height with p = 1/4: P(height > k) = 4^-k. Two trailing
+// zero bits of random per extra level; bit 62 caps it at SKIP_MAX_HEIGHT.
+inline int skipHeight(uint64_t random) {
+    return 1 + __builtin_ctzll(random | (1ULL << 62)) / 2;
+}
+
+// splitmix64 step.
+inline uint64_t skipRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Forward iterator over the keys of a skip list in ascending order.
+// SkipDeleted skips nodes marked deleted by ConcurrentSkipListSet.
+template <bool SkipDeleted>
+class SkipIterator {
+private:
+    SkipNode* node;
+
+    void settle() {
+        if (SkipDeleted) {
+            while (node && node->deleted.load(std::memory_order_acquire)) {
+                node = node->next(0, std::memory_order_acquire);
+            }
+        }
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string*;
+    using reference = const std::string&;
+
+    explicit SkipIterator(SkipNode* n = nullptr) : node(n) { settle(); }
+
+    reference operator*() const { return node->key; }
+    pointer operator->() const { return &node->key; }
+
+    SkipIterator& operator++() {
+        node = node->next(0, std::memory_order_acquire);
+        settle();
+        return *this;
+    }
+
+    SkipIterator operator++(int) {
+        SkipIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const SkipIterator& other) const { return node == other.node; }
+    bool operator!=(const SkipIterator& other) const { return node != other.node; }
+};
+
+// Ordered set of strings. Search, insert and remove take O(log n) expected
+// steps: each node is on level 0 and on every level below its tower height,
+// so a search drops a level after about four steps forward.
+//
+// Towers of all heights are carved from 16 KB slabs of the given
+// NodeAllocator source (the thread's slab cache by default, like a pooled
+// NodeArena); removed towers go on a free list per height and clear()
+// returns every slab at once. A heap() allocator is treated as pool() here,
+// since variable-size towers have no per-node new/delete form.
+class SkipListSet {
+private:
+    struct Slab {
+        Slab* next;
+    };
+
+    struct FreeTower {
+        FreeTower* next;
+    };
+
+    static const size_t SLAB_HEADER = (sizeof(Slab) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    NodeAllocator source;
+    Slab* slabs;
+    char* fresh;
+    char* freshEnd;
+    FreeTower* freeTowers[SKIP_MAX_HEIGHT + 1];
+
+    SkipNode* head;     // sentinel with a full tower, its key is never read
+    int levels;         // levels in use, 1..SKIP_MAX_HEIGHT
+    size_t size;
+    uint64_t seed;
+
+    void* takeTower(int height) {
+        if (freeTowers[height]) {
+            FreeTower* tower = freeTowers[height];
+            freeTowers[height] = tower->next;
+            return tower;
+        }
+        size_t bytes = SkipNode::bytesFor(height);
+        if (static_cast<size_t>(freshEnd - fresh) < bytes) {
+            void* memory = source.resource ? source.resource->allocate(NODE_SLAB_BYTES, alignof(std::max_align_t))
+                                           : NodeSlabCache::local().take();
+            Slab* slab = static_cast<Slab*>(memory);
+            slab->next = slabs;
+            slabs = slab;
+            fresh = static_cast<char*>(memory) + SLAB_HEADER;
+            freshEnd = static_cast<char*>(memory) + NODE_SLAB_BYTES;
+        }
+        void* tower = fresh;
+        fresh += bytes;
+        return tower;
+    }
+
+    SkipNode* create(std::string key, int height) {
+        return SkipNode::construct(takeTower(height), std::move(key), height);
+    }
+
+    void destroy(SkipNode* node) {
+        int height = node->height;
+        node->~SkipNode();
+        FreeTower* tower = reinterpret_cast<FreeTower*>(node);
+        tower->next = freeTowers[height];
+        freeTowers[height] = tower;
+    }
+
+    void releaseSlabs() {
+        while (slabs) {
+            Slab* next = slabs->next;
+            if (source.resource) {
+                source.resource->deallocate(slabs, NODE_SLAB_BYTES, alignof(std::max_align_t));
+            } else {
+                NodeSlabCache::local().give(slabs);
+            }
+            slabs = next;
+        }
+        fresh = freshEnd = nullptr;
+        for (int i = 0; i <= SKIP_MAX_HEIGHT; ++i) freeTowers[i] = nullptr;
+    }
+
+    // Fills preds[level] with the last node whose key is < key on each level
+    // in use; returns the first node with key >= key.
+    SkipNode* findPreds(const std::string& key, SkipNode** preds) const {
+        SkipNode* node = head;
+        for (int level = levels - 1; level >= 0; --level) {
+            SkipNode* next;
+            while ((next = node->next(level)) && next->key < key) node = next;
+            preds[level] = node;
+        }
+        return node->next(0);
+    }
+
+    // Destroys every node including the head; the slabs are kept.
+    void destroyNodes() {
+        SkipNode* node = head;
+        while (node) {
+            SkipNode* next = node->next(0);
+            node->~SkipNode();
+            node = next;
+        }
+        head = nullptr;
+    }
+
+    SkipNode* lowerBound(const std::string& key) const {
+        SkipNode* node = head;
+        for (int level = levels - 1; level >= 0; --level) {
+            SkipNode* next;
+            while ((next = node->next(level)) && next->key < key) node = next;
+        }
+        return node->next(0);
+    }
+
+public:
+    using const_iterator = SkipIterator<false>;
+    using iterator = const_iterator;
+
+    explicit SkipListSet(const NodeAllocator& alloc = NodeAllocator(), uint64_t randomSeed = 0x5EED)
+        : source(alloc), slabs(nullptr), fresh(nullptr), freshEnd(nullptr),
+          levels(1), size(0), seed(randomSeed) {
+        for (int i = 0; i <= SKIP_MAX_HEIGHT; ++i) freeTowers[i] = nullptr;
+        head = create(std::string(), SKIP_MAX_HEIGHT);
+    }
+
+    SkipListSet(const SkipListSet&) = delete;
+    SkipListSet& operator=(const SkipListSet&) = delete;
+
+    ~SkipListSet() {
+        destroyNodes();
+        releaseSlabs();
+    }
+
+    // False if key was already present.
+    bool insert(const std::string& key) {
+        SkipNode* preds[SKIP_MAX_HEIGHT];
+        SkipNode* found = findPreds(key, preds);
+        if (found && found->key == key) return false;
+        int height = skipHeight(skipRandom(seed));
+        for (; levels < height; ++levels) preds[levels] = head;
+        SkipNode* node = create(key, height);
+        for (int level = 0; level < height; ++level) {
+            node->links()[level].store(preds[level]->next(level), std::memory_order_relaxed);
+            preds[level]->links()[level].store(node, std::memory_order_relaxed);
+        }
+        size++;
+        return true;
+    }
+
+    bool contains(const std::string& key) const {
+        SkipNode* node = lowerBound(key);
+        return node && node->key == key;
+    }
+
+    // False if key was not present.
+    bool remove(const std::string& key) {
+        SkipNode* preds[SKIP_MAX_HEIGHT];
+        SkipNode* node = findPreds(key, preds);
+        if (!node || node->key != key) return false;
+        for (int level = 0; level < node->height; ++level) {
+            preds[level]->links()[level].store(node->next(level), std::memory_order_relaxed);
+        }
+        destroy(node);
+        while (levels > 1 && !head->next(levels - 1)) levels--;
+        size--;
+        return true;
+    }
+
+    const_iterator begin() const { return const_iterator(head->next(0)); }
+    const_iterator end() const { return const_iterator(); }
+
+    // First key >= key.
+    const_iterator lower_bound(const std::string& key) const { return const_iterator(lowerBound(key)); }
+
+    // Calls f on every key in [from, to) in order.
+    template <typename F>
+    void for_range(const std::string& from, const std::string& to, F f) const {
+        for (SkipNode* node = lowerBound(from); node && node->key < to; node = node->next(0)) f(node->key);
+    }
+
+    void print() const {
+        for (SkipNode* node = head->next(0); node; node = node->next(0)) std::cout << node->key << " -> ";
+        std::cout << "NULL" << std::endl;
+    }
+
+    void clear() {
+        destroyNodes();
+        releaseSlabs();
+        head = create(std::string(), SKIP_MAX_HEIGHT);
+        levels = 1;
+        size = 0;
+    }
+
+    bool isEmpty() const { return size == 0; }
+
+    size_t get_size() const { return size; }
+    int get_level_count() const { return levels; }
+};
+
+// Skip list set safe for concurrent insert, contains, remove and iteration
+// from any number of threads, without locks.
+//
+// insert links a node bottom-up with one compare-and-swap per level; the
+// level-0 CAS decides whether the key is new, and the upper levels are only
+// shortcuts, so a node counts as present as soon as it is on level 0.
+// remove is logical: it marks the node deleted and leaves it linked, and a
+// later insert of the same key revives it. Since no node is ever unlinked
+// while the set is shared, readers never meet freed memory and no hazard
+// pointers or epochs are needed; the cost is that removed keys keep their
+// node until the set is destroyed or purge() runs.
+//
+// Towers are bump-allocated from 64 KB chunks with one fetch_add; a thread
+// that finds the chunk full installs a new one with a CAS.
+class ConcurrentSkipListSet {
+private:
+    struct Chunk {
+        Chunk* next;
+        std::atomic<size_t> used;
+    };
+
+    static const size_t CHUNK_BYTES = 65536;
+    static const size_t CHUNK_HEADER = (sizeof(Chunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    std::atomic<Chunk*> chunks;
+    SkipNode* head;
+    std::atomic<int> levels;
+    std::atomic<long long> size;
+
+    void* allocate(size_t bytes) {
+        bytes = (bytes + alignof(SkipNode) - 1) / alignof(SkipNode) * alignof(SkipNode);
+        for (;;) {
+            Chunk* chunk = chunks.load(std::memory_order_acquire);
+            if (chunk) {
+                size_t offset = chunk->used.fetch_add(bytes, std::memory_order_relaxed);
+                if (CHUNK_HEADER + offset + bytes <= CHUNK_BYTES) {
+                    return reinterpret_cast<char*>(chunk) + CHUNK_HEADER + offset;
+                }
+            }
+            Chunk* fresh = static_cast<Chunk*>(::operator new(CHUNK_BYTES));
+            fresh->next = chunk;
+            new (&fresh->used) std::atomic<size_t>(0);
+            if (!chunks.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) ::operator delete(fresh);
+        }
+    }
+
+    static uint64_t& threadSeed() {
+        thread_local uint64_t seed = std::hash<std::thread::id>()(std::this_thread::get_id()) ^ 0x5EED;
+        return seed;
+    }
+
+    // preds/succs: the nodes around key on levels [0, top), top being at
+    // least height so the caller can link a tower of that height.
+    void findPreds(const std::string& key, int height, SkipNode** preds, SkipNode** succs) const {
+        int top = levels.load(std::memory_order_relaxed);
+        if (top < height) top = height;
+        SkipNode* node = head;
+        for (int level = top - 1; level >= 0; --level) {
+            SkipNode* next = node->next(level, std::memory_order_acquire);
+            while (next && next->key < key) {
+                node = next;
+                next = node->next(level, std::memory_order_acquire);
+            }
+            preds[level] = node;
+            succs[level] = next;
+        }
+    }
+
+    SkipNode* lowerBound(const std::string& key) const {
+        SkipNode* node = head;
+        for (int level = levels.load(std::memory_order_relaxed) - 1; level >= 0; --level) {
+            SkipNode* next;
+            while ((next = node->next(level, std::memory_order_acquire)) && next->key < key) node = next;
+        }
+        return node->next(0, std::memory_order_acquire);
+    }
+
+    void destroyAll() {
+        SkipNode* node = head->next(0);
+        while (node) {
+            SkipNode* next = node->next(0);
+            node->~SkipNode();
+            node = next;
+        }
+        head->~SkipNode();
+        Chunk* chunk = chunks.load(std::memory_order_relaxed);
+        while (chunk) {
+            Chunk* next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+        chunks.store(nullptr, std::memory_order_relaxed);
+    }
+
+public:
+    using const_iterator = SkipIterator<true>;
+    using iterator = const_iterator;
+
+    ConcurrentSkipListSet() : chunks(nullptr), levels(1), size(0) {
+        head = SkipNode::construct(allocate(SkipNode::bytesFor(SKIP_MAX_HEIGHT)), std::string(), SKIP_MAX_HEIGHT);
+    }
+
+    ConcurrentSkipListSet(const ConcurrentSkipListSet&) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet&) = delete;
+
+    ~ConcurrentSkipListSet() {
+        destroyAll();
+    }
+
+    // False if key was already present.
+    bool insert(const std::string& key) {
+        SkipNode* preds[SKIP_MAX_HEIGHT];
+        SkipNode* succs[SKIP_MAX_HEIGHT];
+        SkipNode* node = nullptr;
+        int height = skipHeight(skipRandom(threadSeed()));
+        for (;;) {
+            findPreds(key, height, preds, succs);
+            SkipNode* found = succs[0];
+            if (found && found->key == key) {
+                // A node built in a round that lost the level-0 race to the
+                // same key stays unused in its chunk.
+                if (node) node->~SkipNode();
+                bool expected = true;
+                if (!found->deleted.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) return false;
+                size.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (!node) node = SkipNode::construct(allocate(SkipNode::bytesFor(height)), key, height);
+            node->links()[0].store(succs[0], std::memory_order_relaxed);
+            SkipNode* expected = succs[0];
+            if (preds[0]->links()[0].compare_exchange_strong(expected, node, std::memory_order_release,
+                                                             std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        size.fetch_add(1, std::memory_order_relaxed);
+        for (int level = 1; level < height; ++level) {
+            for (;;) {
+                node->links()[level].store(succs[level], std::memory_order_relaxed);
+                SkipNode* expected = succs[level];
+                if (preds[level]->links()[level].compare_exchange_strong(expected, node, std::memory_order_release,
+                                                                         std::memory_order_relaxed)) {
+                    break;
+                }
+                findPreds(key, height, preds, succs);
+            }
+        }
+        int seen = levels.load(std::memory_order_relaxed);
+        while (seen < height && !levels.compare_exchange_weak(seen, height, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+
+    bool contains(const std::string& key) const {
+        SkipNode* node = lowerBound(key);
+        return node && node->key == key && !node->deleted.load(std::memory_order_acquire);
+    }
+
+    // Marks key deleted; false if it was not present.
+    bool remove(const std::string& key) {
+        SkipNode* node = lowerBound(key);
+        if (!node || node->key != key) return false;
+        bool expected = false;
+        if (!node->deleted.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) return false;
+        size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Iteration is weakly consistent under concurrent updates: every key
+    // present throughout is visited once, in order.
+    const_iterator begin() const { return const_iterator(head->next(0, std::memory_order_acquire)); }
+    const_iterator end() const { return const_iterator(); }
+
+    const_iterator lower_bound(const std::string& key) const { return const_iterator(lowerBound(key)); }
+
+    template <typename F>
+    void for_range(const std::string& from, const std::string& to, F f) const {
+        for (const_iterator it = lower_bound(from); it != end() && *it < to; ++it) f(*it);
+    }
+
+    // Unlinks the nodes marked deleted. Their memory stays in the chunks
+    // until the set is destroyed. Not thread-safe: no other thread may use
+    // the set meanwhile.
+    void purge() {
+        SkipNode* preds[SKIP_MAX_HEIGHT];
+        for (int level = 0; level < SKIP_MAX_HEIGHT; ++level) preds[level] = head;
+        SkipNode* node = head->next(0);
+        while (node) {
+            SkipNode* next = node->next(0);
+            if (node->deleted.load(std::memory_order_relaxed)) {
+                for (int level = 0; level < node->height; ++level) {
+                    preds[level]->links()[level].store(node->next(level), std::memory_order_relaxed);
+                }
+                node->~SkipNode();
+            } else {
+                for (int level = 0; level < node->height; ++level) preds[level] = node;
+            }
+            node = next;
+        }
+    }
+
+    bool isEmpty() const { return get_size() == 0; }
+
+    size_t get_size() const {
+        long long n = size.load(std::memory_order_relaxed);
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+};
+
+#endif
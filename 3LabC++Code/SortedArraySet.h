@@ -0,0 +1,67 @@
+#ifndef SORTED_ARRAY_SET_H
+#define SORTED_ARRAY_SET_H
+
+#include <string>
+#include <thread>
+#include <utility>
+#include "DynamicArray.h"
+
+// Ordered set kept as one sorted DynamicArray ("flat set"). Lookups are a
+// binary search over contiguous storage; insert/remove shift the tail like
+// DynamicArray::insert. Build from a whole array to pay one sort instead
+// of n shifting inserts.
+template <typename T = std::string>
+class SortedArraySet {
+private:
+    DynamicArray<T> items;
+
+public:
+    SortedArraySet() {}
+
+    explicit SortedArraySet(DynamicArray<T> values, unsigned threads = std::thread::hardware_concurrency())
+        : items(std::move(values)) {
+        items.sort(threads);
+        items.unique();
+    }
+
+    // Returns false if the value was already present.
+    bool insert(const T& value) {
+        int index = items.lower_bound(value);
+        if (index < items.get_size() && items[index] == value) return false;
+        items.insert(index, value);
+        return true;
+    }
+
+    bool remove(const T& value) {
+        int index = index_of(value);
+        if (index < 0) return false;
+        items.remove_at(index);
+        return true;
+    }
+
+    bool contains(const T& value) const {
+        return index_of(value) >= 0;
+    }
+
+    // Position of value in sorted order, or -1 if absent.
+    int index_of(const T& value) const {
+        int index = items.lower_bound(value);
+        return index < items.get_size() && items[index] == value ? index : -1;
+    }
+
+    int lower_bound(const T& value) const {
+        return items.lower_bound(value);
+    }
+
+    T get(int index) const { return items.get(index); }
+    const T& operator[](int index) const { return items[index]; }
+
+    void print() const { items.print(); }
+    void clear() { items.clear(); }
+
+    const DynamicArray<T>& get_items() const { return items; }
+    bool isEmpty() const { return items.get_size() == 0; }
+    int get_size() const { return items.get_size(); }
+};
+
+#endif
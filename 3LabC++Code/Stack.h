@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include "NodePool.h"
 
 struct SNode {
     std::string data;
@@ -14,25 +15,26 @@ class Stack {
 private:
     SNode* top;
     size_t size;
+    NodeArena<SNode> nodes;
 
 public:
-    Stack() : top(nullptr), size(0) {}
+    explicit Stack(const NodeAllocator& alloc = NodeAllocator()) : top(nullptr), size(0), nodes(alloc) {}
 
     ~Stack() {
         clear();
     }
 
     void push(const std::string& value) {
-        top = new SNode(value, top);
+        top = nodes.create(value, top);
         size++;
     }
 
     std::string pop() {
         if (!top) return "";
-        std::string val = top->data;
+        std::string val = std::move(top->data);
         SNode* temp = top;
         top = top->next;
-        delete temp;
+        nodes.destroy(temp);
         size--;
         return val;
     }
@@ -55,7 +57,13 @@ public:
     }
 
     void clear() {
-        while (top) pop();
+        while (top) {
+            SNode* next = top->next;
+            nodes.dispose(top);
+            top = next;
+        }
+        nodes.release();
+        size = 0;
     }
 
     size_t get_size() const { return size; }
@@ -0,0 +1,221 @@
+#ifndef STRING_POOL_ARRAY_H
+#define STRING_POOL_ARRAY_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DynamicArray.h"
+#include "SimdScan.h"
+
+// Column of strings stored in one byte blob. Each string is written as a
+// LEB128 length (one byte below 128) followed by its bytes, and the
+// element table holds only its 8-byte offset: about 9 bytes of bookkeeping
+// per element instead of a 32-byte std::string plus its own heap block.
+// get() returns a view into the blob, valid until the array next changes.
+//
+// set() and insert() append their bytes to the end of the blob, and
+// remove_at()/set() leave the old bytes behind as garbage. compact()
+// rewrites the blob in index order; it also runs automatically once the
+// garbage outgrows the live bytes.
+class StringPoolArray {
+private:
+    std::vector<char> blob;
+    std::vector<uint64_t> offsets;
+    size_t garbage;
+
+    static size_t prefixSize(size_t len) {
+        size_t n = 1;
+        while (len >= 0x80) {
+            len >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    // Length of the entry at offset; advances offset past the prefix.
+    size_t readLength(uint64_t& offset) const {
+        size_t len = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = static_cast<unsigned char>(blob[offset++]);
+            len |= static_cast<size_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return len;
+    }
+
+    size_t entrySize(uint64_t offset) const {
+        size_t len = readLength(offset);
+        return prefixSize(len) + len;
+    }
+
+    uint64_t appendBytes(std::string_view value) {
+        std::less_equal<const char*> le;
+        if (!value.empty() && le(blob.data(), value.data()) && le(value.data(), blob.data() + blob.size())) {
+            // The view points into the blob itself, which may reallocate.
+            std::string copy(value);
+            return appendBytes(copy);
+        }
+        uint64_t offset = blob.size();
+        size_t len = value.size();
+        while (len >= 0x80) {
+            blob.push_back(static_cast<char>((len & 0x7F) | 0x80));
+            len >>= 7;
+        }
+        blob.push_back(static_cast<char>(len));
+        blob.insert(blob.end(), value.begin(), value.end());
+        return offset;
+    }
+
+    // Index of the first element at or after from whose bytes satisfy
+    // match(view), or -1. The length prefix is decoded before the bytes are
+    // touched, so length mismatches are rejected without reading them.
+    template <typename Match>
+    int findIf(int from, Match match) const {
+        for (int i = from < 0 ? 0 : from; i < get_size(); ++i) {
+            if (match(view(i))) return i;
+        }
+        return -1;
+    }
+
+    template <typename Match>
+    int countIf(Match match) const {
+        int found = 0;
+        for (int i = 0; i < get_size(); ++i) found += match(view(i));
+        return found;
+    }
+
+    std::string_view view(int index) const {
+        uint64_t offset = offsets[index];
+        size_t len = readLength(offset);
+        return std::string_view(blob.data() + offset, len);
+    }
+
+    void maybeCompact() {
+        if (garbage > 4096 && garbage > blob.size() - garbage) compact();
+    }
+
+public:
+    StringPoolArray() : garbage(0) {}
+
+    // Pre-sizes for count more elements holding bytes characters in total.
+    void reserve(int count, size_t bytes) {
+        offsets.reserve(offsets.size() + count);
+        blob.reserve(blob.size() + bytes + count);
+    }
+
+    void push_back(std::string_view value) {
+        offsets.push_back(appendBytes(value));
+    }
+
+    // Appends every element of arr with a single blob reservation.
+    void append(const DynamicArray<std::string>& arr) {
+        size_t bytes = 0;
+        for (int i = 0; i < arr.get_size(); ++i) bytes += arr[i].size();
+        reserve(arr.get_size(), bytes);
+        for (int i = 0; i < arr.get_size(); ++i) push_back(arr[i]);
+    }
+
+    void insert(int index, std::string_view value) {
+        if (index < 0 || index > get_size()) return;
+        uint64_t offset = appendBytes(value);
+        offsets.insert(offsets.begin() + index, offset);
+    }
+
+    std::string_view get(int index) const {
+        if (index < 0 || index >= get_size()) return std::string_view();
+        return view(index);
+    }
+
+    int find(std::string_view value, int from = 0) const {
+        return findIf(from, [value](std::string_view s) { return simdStringEqual(s, value); });
+    }
+
+    int count(std::string_view value) const {
+        return countIf([value](std::string_view s) { return simdStringEqual(s, value); });
+    }
+
+    bool contains_any(const DynamicArray<std::string>& values) const {
+        int k = values.get_size();
+        if (k == 0) return false;
+        unsigned long long lengths = lengthFilter(values, k);
+        return findIf(0, [&](std::string_view s) {
+            if (!(lengths >> (s.size() & 63) & 1)) return false;
+            for (int j = 0; j < k; ++j) {
+                if (simdStringEqual(s, values[j])) return true;
+            }
+            return false;
+        }) >= 0;
+    }
+
+    int find_prefix(std::string_view prefix, int from = 0) const {
+        return findIf(from, [prefix](std::string_view s) { return simdStartsWith(s, prefix); });
+    }
+
+    int count_prefix(std::string_view prefix) const {
+        return countIf([prefix](std::string_view s) { return simdStartsWith(s, prefix); });
+    }
+
+    void set(int index, std::string_view value) {
+        if (index < 0 || index >= get_size()) return;
+        uint64_t offset = offsets[index];
+        size_t oldLen = readLength(offset);
+        if (value.size() == oldLen) {
+            std::memmove(blob.data() + offset, value.data(), value.size());
+            return;
+        }
+        garbage += prefixSize(oldLen) + oldLen;
+        offsets[index] = appendBytes(value);
+        maybeCompact();
+    }
+
+    void remove_at(int index) {
+        if (index < 0 || index >= get_size()) return;
+        garbage += entrySize(offsets[index]);
+        offsets.erase(offsets.begin() + index);
+        maybeCompact();
+    }
+
+    // Drops garbage bytes and lays the strings out in index order, so a
+    // full scan reads the blob strictly sequentially.
+    void compact() {
+        std::vector<char> packed;
+        packed.reserve(blob.size() - garbage);
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            uint64_t offset = packed.size();
+            auto first = blob.begin() + offsets[i];
+            packed.insert(packed.end(), first, first + entrySize(offsets[i]));
+            offsets[i] = offset;
+        }
+        blob.swap(packed);
+        garbage = 0;
+    }
+
+    void print() const {
+        for (int i = 0; i < get_size(); ++i) {
+            std::cout << get(i) << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    void clear() {
+        blob.clear();
+        offsets.clear();
+        garbage = 0;
+    }
+
+    // Heap bytes held by the column, including reserved capacity.
+    size_t memory_usage() const {
+        return blob.capacity() + offsets.capacity() * sizeof(uint64_t);
+    }
+
+    int get_size() const { return static_cast<int>(offsets.size()); }
+    size_t get_garbage() const { return garbage; }
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include "NodePool.h"
+
+// Block of a doubly linked unrolled list: up to Capacity strings stored in
+// order, items[0..count).
+template <int Capacity>
+struct UNode {
+    std::string items[Capacity];
+    int count;
+    UNode* next;
+    UNode* prev;
+    UNode(UNode* nxt = nullptr, UNode* prv = nullptr) : count(0), next(nxt), prev(prv) {}
+};
+
+// Doubly linked list of blocks with the value-based API of
+// DoublyLinkedList. A scan touches one block per Capacity elements instead
+// of one node per element, and the link overhead is shared the same way.
+// The default of 4 strings per block is 128 bytes of elements plus the
+// count and two links, 152 bytes: under three cache lines per four values
+// against one LNode (48 bytes) per value.
+//
+// A full block is split in half on insert. After a delete a block is
+// merged into a neighbour whenever the two fit in one; otherwise, if it
+// fell under half full, it borrows one element from a neighbour. Apart from
+// the first and last block, which push_front / push_back fill one element
+// at a time, every block stays at least half full.
+template <int Capacity = 4>
+class UnrolledLinkedList {
+    static_assert(Capacity >= 2, "a block must hold at least two elements");
+
+public:
+    using Node = UNode<Capacity>;
+
+private:
+    Node* head;
+    Node* tail;
+    size_t size;
+    size_t blocks;
+    NodeArena<Node> nodes;
+
+    Node* linkAfter(Node* node) {
+        Node* block = nodes.create(node ? node->next : head, node);
+        if (block->next) block->next->prev = block;
+        else tail = block;
+        if (node) node->next = block;
+        else head = block;
+        blocks++;
+        return block;
+    }
+
+    void unlink(Node* node) {
+        if (node->prev) node->prev->next = node->next;
+        else head = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else tail = node->prev;
+        nodes.destroy(node);
+        blocks--;
+    }
+
+    // Position of the first element equal to value; false if absent.
+    bool locate(const std::string& value, Node*& node, int& index) const {
+        for (Node* block = head; block; block = block->next) {
+            for (int i = 0; i < block->count; ++i) {
+                if (block->items[i] == value) {
+                    node = block;
+                    index = i;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Inserts value before position index of node (index == count appends).
+    // value is taken by copy since it may refer to an element of the list.
+    void insertAt(Node* node, int index, std::string value) {
+        if (node->count == Capacity) {
+            Node* upper = linkAfter(node);
+            int half = Capacity / 2;
+            for (int i = half; i < Capacity; ++i) upper->items[i - half] = std::move(node->items[i]);
+            upper->count = Capacity - half;
+            node->count = half;
+            if (index > half) {
+                node = upper;
+                index -= half;
+            }
+        }
+        for (int i = node->count; i > index; --i) node->items[i] = std::move(node->items[i - 1]);
+        node->items[index] = std::move(value);
+        node->count++;
+        size++;
+    }
+
+    // Appends the elements of from to into and unlinks from; both are
+    // neighbours and fit in one block.
+    void mergeInto(Node* into, Node* from) {
+        for (int i = 0; i < from->count; ++i) into->items[into->count + i] = std::move(from->items[i]);
+        into->count += from->count;
+        unlink(from);
+    }
+
+    void eraseAt(Node* node, int index) {
+        for (int i = index; i + 1 < node->count; ++i) node->items[i] = std::move(node->items[i + 1]);
+        node->items[--node->count] = std::string();
+        size--;
+        if (node->count == 0) {
+            unlink(node);
+            return;
+        }
+        if (node->prev && node->prev->count + node->count <= Capacity) {
+            mergeInto(node->prev, node);
+            return;
+        }
+        Node* next = node->next;
+        if (next && node->count + next->count <= Capacity) {
+            mergeInto(node, next);
+            return;
+        }
+        // Neither merge fits, so a neighbour holds more than
+        // Capacity - count elements and keeps at least half after lending one.
+        if (node->count >= Capacity / 2) return;
+        if (next) {
+            node->items[node->count++] = std::move(next->items[0]);
+            for (int i = 0; i + 1 < next->count; ++i) next->items[i] = std::move(next->items[i + 1]);
+            next->items[--next->count] = std::string();
+        } else if (node->prev) {
+            Node* prev = node->prev;
+            for (int i = node->count; i > 0; --i) node->items[i] = std::move(node->items[i - 1]);
+            node->items[0] = std::move(prev->items[--prev->count]);
+            node->count++;
+            prev->items[prev->count] = std::string();
+        }
+    }
+
+public:
+    explicit UnrolledLinkedList(const NodeAllocator& alloc = NodeAllocator())
+        : head(nullptr), tail(nullptr), size(0), blocks(0), nodes(alloc) {}
+
+    UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+
+    ~UnrolledLinkedList() {
+        clear();
+    }
+
+    void push_front(const std::string& value) {
+        if (!head || head->count == Capacity) linkAfter(nullptr);
+        insertAt(head, 0, value);
+    }
+
+    // A full tail gets a fresh block rather than a split, so appending
+    // leaves every block full.
+    void push_back(const std::string& value) {
+        if (!tail || tail->count == Capacity) linkAfter(tail);
+        insertAt(tail, tail->count, value);
+    }
+
+    void pop_front() {
+        if (!head) return;
+        eraseAt(head, 0);
+    }
+
+    void pop_back() {
+        if (!tail) return;
+        eraseAt(tail, tail->count - 1);
+    }
+
+    void remove_value(const std::string& value) {
+        Node* node;
+        int index;
+        if (locate(value, node, index)) eraseAt(node, index);
+    }
+
+    // Pointer to the first element equal to value, or nullptr. Valid until
+    // the list is modified.
+    const std::string* find(const std::string& value) const {
+        Node* node;
+        int index;
+        return locate(value, node, index) ? &node->items[index] : nullptr;
+    }
+
+    bool contains(const std::string& value) const {
+        return find(value) != nullptr;
+    }
+
+    bool insert_after(const std::string& target, const std::string& value) {
+        Node* node;
+        int index;
+        if (!locate(target, node, index)) return false;
+        insertAt(node, index + 1, value);
+        return true;
+    }
+
+    bool insert_before(const std::string& target, const std::string& value) {
+        Node* node;
+        int index;
+        if (!locate(target, node, index)) return false;
+        insertAt(node, index, value);
+        return true;
+    }
+
+    bool delete_after(const std::string& target) {
+        Node* node;
+        int index;
+        if (!locate(target, node, index)) return false;
+        if (index + 1 < node->count) {
+            eraseAt(node, index + 1);
+        } else {
+            if (!node->next) return false;
+            eraseAt(node->next, 0);
+        }
+        return true;
+    }
+
+    bool delete_before(const std::string& target) {
+        Node* node;
+        int index;
+        if (!locate(target, node, index)) return false;
+        if (index > 0) {
+            eraseAt(node, index - 1);
+        } else {
+            if (!node->prev) return false;
+            eraseAt(node->prev, node->prev->count - 1);
+        }
+        return true;
+    }
+
+    // Element at position index, or "" if out of range.
+    std::string get(size_t index) const {
+        for (Node* block = head; block; block = block->next) {
+            if (index < static_cast<size_t>(block->count)) return block->items[index];
+            index -= block->count;
+        }
+        return "";
+    }
+
+    void print() const {
+        for (Node* block = head; block; block = block->next) {
+            for (int i = 0; i < block->count; ++i) std::cout << block->items[i] << " <-> ";
+        }
+        std::cout << "NULL" << std::endl;
+    }
+
+    void clear() {
+        while (head) {
+            Node* next = head->next;
+            nodes.dispose(head);
+            head = next;
+        }
+        nodes.release();
+        tail = nullptr;
+        size = 0;
+        blocks = 0;
+    }
+
+    bool isEmpty() const { return head == nullptr; }
+
+    Node* getHead() const { return head; }
+    Node* getTail() const { return tail; }
+    size_t get_size() const { return size; }
+    size_t get_block_count() const { return blocks; }
+};
+
+#endif
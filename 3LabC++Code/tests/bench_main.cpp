@@ -7,9 +7,33 @@
 #include <queue>
 #include <list>
 #include "DynamicArray.h"
+#include "StringPoolArray.h"
+#include "GapBufferArray.h"
+#include "SegmentedArray.h"
 #include "SinglyList.h"
 #include "DoublyList.h"
+#include "UnrolledList.h"
+#include "CompactList.h"
+#include "SkipList.h"
 #include "HashTable.h"
+#include "HashTableOpen.h"
+#include "BinarySearchTree.h"
+#include "EytzingerTree.h"
+#include "MappedArray.h"
+#include "ExternalSort.h"
+#include "Serialization.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <chrono>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // 1. Benchmark: DynamicArray vs std::vector
 static void BM_DynamicArray_Push(benchmark::State& state) {
@@ -32,6 +56,499 @@ static void BM_StdVector_Push(benchmark::State& state) {
 }
 BENCHMARK(BM_StdVector_Push)->Range(8, 1024);
 
+// Strings past the small-string buffer: every copy is a heap allocation.
+static const std::string kLongString(40, 'x');
+
+static void BM_DynamicArray_PushLong(benchmark::State& state) {
+    for (auto _ : state) {
+        DynamicArray<std::string> arr;
+        for (int i = 0; i < state.range(0); ++i) arr.push_back(kLongString);
+        benchmark::DoNotOptimize(arr.get_size());
+    }
+}
+BENCHMARK(BM_DynamicArray_PushLong)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_StdVector_PushLong(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<std::string> vec;
+        for (int i = 0; i < state.range(0); ++i) vec.push_back(kLongString);
+        benchmark::DoNotOptimize(vec.size());
+    }
+}
+BENCHMARK(BM_StdVector_PushLong)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_DynamicArray_PushInt(benchmark::State& state) {
+    for (auto _ : state) {
+        DynamicArray<int> arr;
+        for (int i = 0; i < state.range(0); ++i) arr.push_back(i);
+        benchmark::DoNotOptimize(arr.get_size());
+    }
+}
+BENCHMARK(BM_DynamicArray_PushInt)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_StdVector_PushInt(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<int> vec;
+        for (int i = 0; i < state.range(0); ++i) vec.push_back(i);
+        benchmark::DoNotOptimize(vec.size());
+    }
+}
+BENCHMARK(BM_StdVector_PushInt)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+// Many short-lived arrays of a few ints: the inline buffer avoids the
+// allocator entirely while the array stays within N elements.
+template <typename Array>
+static void SmallArrays(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int n = 0; n < 1000; ++n) {
+            Array arr;
+            for (int i = 0; i < state.range(0); ++i) arr.push_back(i);
+            benchmark::DoNotOptimize(arr);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+static void BM_DynamicArray_SmallArrays(benchmark::State& state) { SmallArrays<DynamicArray<int>>(state); }
+BENCHMARK(BM_DynamicArray_SmallArrays)->Arg(2)->Arg(8)->Arg(16);
+
+static void BM_DynamicArrayInline8_SmallArrays(benchmark::State& state) { SmallArrays<DynamicArray<int, 8>>(state); }
+BENCHMARK(BM_DynamicArrayInline8_SmallArrays)->Arg(2)->Arg(8)->Arg(16);
+
+static void BM_StdVector_SmallArrays(benchmark::State& state) { SmallArrays<std::vector<int>>(state); }
+BENCHMARK(BM_StdVector_SmallArrays)->Arg(2)->Arg(8)->Arg(16);
+
+// CURSOR-LOCAL EDITS on 1M strings: the cursor random-walks a few slots
+// between edits, alternating inserts and removes so the size stays put.
+template <typename Array>
+static void CursorEdits(benchmark::State& state) {
+    const int n = 1 << 20;
+    Array arr;
+    for (int i = 0; i < n; ++i) arr.push_back("line " + std::to_string(i));
+    std::mt19937 rng(42);
+    int cursor = n / 2;
+    for (auto _ : state) {
+        for (int e = 0; e < 100; ++e) {
+            cursor += static_cast<int>(rng() % 9) - 4;
+            cursor = std::max(0, std::min(cursor, arr.get_size() - 1));
+            if (e & 1) arr.remove_at(cursor);
+            else arr.insert(cursor, "typed");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+
+static void BM_DynamicArray_CursorEdits(benchmark::State& state) { CursorEdits<DynamicArray<std::string>>(state); }
+BENCHMARK(BM_DynamicArray_CursorEdits)->Unit(benchmark::kMicrosecond);
+
+static void BM_GapBuffer_CursorEdits(benchmark::State& state) { CursorEdits<GapBufferArray<std::string>>(state); }
+BENCHMARK(BM_GapBuffer_CursorEdits)->Unit(benchmark::kMicrosecond);
+
+// GROWTH PROFILE: N int push_backs from empty.
+// max_push_us is the slowest single push_back (the doubling copy for
+// contiguous arrays). peak_rss_mb is the high-water RSS of a forked child
+// that only fills the array, minus that of an idle child.
+static long childPeakRssKb(void (*work)(int), int n) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (work) work(n);
+        _exit(0);
+    }
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    return usage.ru_maxrss;
+}
+
+template <typename Array>
+static void FillOnly(int n) {
+    Array arr;
+    for (int i = 0; i < n; ++i) arr.push_back(i);
+    benchmark::DoNotOptimize(arr);
+}
+
+template <typename Array>
+static void GrowthProfile(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    double worst = 0;
+    for (auto _ : state) {
+        Array arr;
+        for (int i = 0; i < n; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            arr.push_back(i);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            worst = std::max(worst, std::chrono::duration<double, std::micro>(elapsed).count());
+        }
+        benchmark::DoNotOptimize(arr);
+    }
+    long idle = childPeakRssKb(nullptr, 0);
+    state.counters["max_push_us"] = worst;
+    state.counters["peak_rss_mb"] = (childPeakRssKb(&FillOnly<Array>, n) - idle) / 1024.0;
+}
+
+static void BM_DynamicArray_Growth(benchmark::State& state) { GrowthProfile<DynamicArray<int>>(state); }
+BENCHMARK(BM_DynamicArray_Growth)->Arg(1 << 20)->Arg((1 << 25) + 1)->Iterations(2)->Unit(benchmark::kMillisecond);
+
+static void BM_StdVector_Growth(benchmark::State& state) { GrowthProfile<std::vector<int>>(state); }
+BENCHMARK(BM_StdVector_Growth)->Arg(1 << 20)->Arg((1 << 25) + 1)->Iterations(2)->Unit(benchmark::kMillisecond);
+
+static void BM_SegmentedArray_Growth(benchmark::State& state) { GrowthProfile<SegmentedArray<int>>(state); }
+BENCHMARK(BM_SegmentedArray_Growth)->Arg(1 << 20)->Arg((1 << 25) + 1)->Iterations(2)->Unit(benchmark::kMillisecond);
+
+// STRING POOL vs DynamicArray<std::string>: 8..24 byte strings.
+// The "bytes" counter is the heap held by the container (for std::string
+// elements: slot array plus one block per string past the SSO buffer).
+
+static std::vector<std::string> benchShortStrings(int n) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> len(8, 24);
+    std::vector<std::string> out(n);
+    for (auto& str : out) str.assign(len(rng), 'a' + rng() % 26);
+    return out;
+}
+
+static void BM_DynamicArray_ScanStrings(benchmark::State& state) {
+    std::vector<std::string> source = benchShortStrings(state.range(0));
+    DynamicArray<std::string> arr;
+    size_t bytes = 0;
+    for (const auto& str : source) {
+        arr.push_back(str);
+        if (str.size() > 15) bytes += (str.size() + 1 + 15) / 16 * 16;
+    }
+    bytes += arr.get_capacity() * sizeof(std::string);
+    for (auto _ : state) {
+        size_t total = 0;
+        for (int i = 0; i < arr.get_size(); ++i) total += arr[i].size() + arr[i][0];
+        benchmark::DoNotOptimize(total);
+    }
+    state.counters["bytes"] = bytes;
+}
+BENCHMARK(BM_DynamicArray_ScanStrings)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_StringPool_ScanStrings(benchmark::State& state) {
+    std::vector<std::string> source = benchShortStrings(state.range(0));
+    StringPoolArray arr;
+    for (const auto& str : source) arr.push_back(str);
+    arr.compact();
+    for (auto _ : state) {
+        size_t total = 0;
+        for (int i = 0; i < arr.get_size(); ++i) {
+            std::string_view str = arr.get(i);
+            total += str.size() + str[0];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.counters["bytes"] = arr.memory_usage();
+}
+BENCHMARK(BM_StringPool_ScanStrings)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// BULK QUERIES over 1M elements: the member kernels vs the caller-side
+// get(i) loop they replace. Needles are absent, so every scan is full.
+static DynamicArray<int>& queryInts() {
+    static DynamicArray<int> arr;
+    if (arr.get_size() == 0) {
+        for (int i = 0; i < (1 << 20); ++i) arr.push_back(i & 0xFFFF);
+    }
+    return arr;
+}
+
+static void BM_DynamicArrayInt_FindScalar(benchmark::State& state) {
+    const DynamicArray<int>& arr = queryInts();
+    for (auto _ : state) {
+        int found = -1;
+        for (int i = 0; i < arr.get_size(); ++i) {
+            if (arr.get(i) == -5) { found = i; break; }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetBytesProcessed(state.iterations() * arr.get_size() * sizeof(int));
+}
+BENCHMARK(BM_DynamicArrayInt_FindScalar)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynamicArrayInt_Find(benchmark::State& state) {
+    const DynamicArray<int>& arr = queryInts();
+    for (auto _ : state) benchmark::DoNotOptimize(arr.find(-5));
+    state.SetBytesProcessed(state.iterations() * arr.get_size() * sizeof(int));
+}
+BENCHMARK(BM_DynamicArrayInt_Find)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynamicArrayInt_Count(benchmark::State& state) {
+    const DynamicArray<int>& arr = queryInts();
+    for (auto _ : state) benchmark::DoNotOptimize(arr.count(7));
+    state.SetBytesProcessed(state.iterations() * arr.get_size() * sizeof(int));
+}
+BENCHMARK(BM_DynamicArrayInt_Count)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynamicArrayInt_ContainsAny4(benchmark::State& state) {
+    const DynamicArray<int>& arr = queryInts();
+    DynamicArray<int> needles;
+    for (int v : {-1, -2, -3, -4}) needles.push_back(v);
+    for (auto _ : state) benchmark::DoNotOptimize(arr.contains_any(needles));
+    state.SetBytesProcessed(state.iterations() * arr.get_size() * sizeof(int));
+}
+BENCHMARK(BM_DynamicArrayInt_ContainsAny4)->Unit(benchmark::kMicrosecond);
+
+// Same-length candidates exist for this needle, so the byte compare runs.
+static const std::string kAbsentNeedle = "aaaaaaaaaaaaaaab";
+
+static std::pair<DynamicArray<std::string>, StringPoolArray>& scanStrings() {
+    static std::pair<DynamicArray<std::string>, StringPoolArray> cache;
+    if (cache.first.get_size() == 0) {
+        for (const std::string& str : benchShortStrings(1 << 20)) {
+            cache.first.push_back(str);
+            cache.second.push_back(str);
+        }
+    }
+    return cache;
+}
+
+static void BM_DynamicArrayString_FindScalar(benchmark::State& state) {
+    const DynamicArray<std::string>& arr = scanStrings().first;
+    for (auto _ : state) {
+        int found = -1;
+        for (int i = 0; i < arr.get_size(); ++i) {
+            if (arr.get(i) == kAbsentNeedle) { found = i; break; }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_DynamicArrayString_FindScalar)->Unit(benchmark::kMillisecond);
+
+static void BM_DynamicArrayString_Find(benchmark::State& state) {
+    const DynamicArray<std::string>& arr = scanStrings().first;
+    for (auto _ : state) benchmark::DoNotOptimize(arr.find(kAbsentNeedle));
+}
+BENCHMARK(BM_DynamicArrayString_Find)->Unit(benchmark::kMillisecond);
+
+static void BM_StringPool_FindScalar(benchmark::State& state) {
+    const StringPoolArray& pool = scanStrings().second;
+    for (auto _ : state) {
+        int found = -1;
+        for (int i = 0; i < pool.get_size(); ++i) {
+            if (pool.get(i) == kAbsentNeedle) { found = i; break; }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_StringPool_FindScalar)->Unit(benchmark::kMillisecond);
+
+static void BM_StringPool_Find(benchmark::State& state) {
+    const StringPoolArray& pool = scanStrings().second;
+    for (auto _ : state) benchmark::DoNotOptimize(pool.find(kAbsentNeedle));
+}
+BENCHMARK(BM_StringPool_Find)->Unit(benchmark::kMillisecond);
+
+static void BM_StringPool_CountPrefixScalar(benchmark::State& state) {
+    const StringPoolArray& pool = scanStrings().second;
+    for (auto _ : state) {
+        int found = 0;
+        for (int i = 0; i < pool.get_size(); ++i) found += pool.get(i).substr(0, 3) == "aaa";
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_StringPool_CountPrefixScalar)->Unit(benchmark::kMillisecond);
+
+static void BM_StringPool_CountPrefix(benchmark::State& state) {
+    const StringPoolArray& pool = scanStrings().second;
+    for (auto _ : state) benchmark::DoNotOptimize(pool.count_prefix("aaa"));
+}
+BENCHMARK(BM_StringPool_CountPrefix)->Unit(benchmark::kMillisecond);
+
+// SORT: DynamicArray::sort vs the copy-out / std::sort / copy-back round
+// trip it replaces. Args: {elements, threads}.
+template <typename T>
+static const DynamicArray<T>& unsortedSource(int n) {
+    static DynamicArray<T> source;
+    if (source.get_size() != n) {
+        std::mt19937 rng(11);
+        source.clear();
+        for (int i = 0; i < n; ++i) {
+            if constexpr (std::is_same<T, std::string>::value) {
+                std::string str(8 + rng() % 17, ' ');
+                for (char& c : str) c = 'a' + rng() % 26;
+                source.push_back(str);
+            } else {
+                source.push_back(static_cast<T>(rng()));
+            }
+        }
+    }
+    return source;
+}
+
+template <typename T>
+static void SortRoundTrip(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        DynamicArray<T> arr(unsortedSource<T>(state.range(0)));
+        state.ResumeTiming();
+        std::vector<T> vec;
+        vec.reserve(arr.get_size());
+        for (int i = 0; i < arr.get_size(); ++i) vec.push_back(arr.get(i));
+        std::sort(vec.begin(), vec.end());
+        for (int i = 0; i < arr.get_size(); ++i) arr.set(i, vec[i]);
+        benchmark::DoNotOptimize(arr);
+    }
+}
+
+template <typename T>
+static void SortInPlace(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        DynamicArray<T> arr(unsortedSource<T>(state.range(0)));
+        state.ResumeTiming();
+        arr.sort(static_cast<unsigned>(state.range(1)));
+        benchmark::DoNotOptimize(arr);
+    }
+}
+
+static void BM_SortIntRoundTrip(benchmark::State& state) { SortRoundTrip<int>(state); }
+BENCHMARK(BM_SortIntRoundTrip)->Args({1 << 20, 1})->Unit(benchmark::kMillisecond);
+static void BM_SortIntInPlace(benchmark::State& state) { SortInPlace<int>(state); }
+BENCHMARK(BM_SortIntInPlace)->Args({1 << 20, 1})->Args({1 << 20, 4})->Unit(benchmark::kMillisecond);
+
+static void BM_SortStringRoundTrip(benchmark::State& state) { SortRoundTrip<std::string>(state); }
+BENCHMARK(BM_SortStringRoundTrip)->Args({1 << 20, 1})->Unit(benchmark::kMillisecond);
+static void BM_SortStringInPlace(benchmark::State& state) { SortInPlace<std::string>(state); }
+BENCHMARK(BM_SortStringInPlace)->Args({1 << 20, 1})->Args({1 << 20, 4})->Unit(benchmark::kMillisecond);
+
+// REOPEN 1M strings: mapping an existing MappedStringArray vs parsing the
+// same data with loadFromBinary. Files are written once and stay in the
+// page cache, so this measures the deserialization cost itself.
+static void writeReopenFiles() {
+    static bool written = false;
+    if (written) return;
+    std::remove("bench_mapped.idx");
+    std::remove("bench_mapped.blob");
+    const DynamicArray<std::string>& source = scanStrings().first;
+    MappedStringArray mapped("bench_mapped", source.get_size());
+    for (int i = 0; i < source.get_size(); ++i) mapped.push_back(source[i]);
+    saveToBinary(source, "bench_array.bin");
+    written = true;
+}
+
+static void BM_MappedString_Reopen(benchmark::State& state) {
+    writeReopenFiles();
+    for (auto _ : state) {
+        MappedStringArray arr("bench_mapped");
+        benchmark::DoNotOptimize(arr.get(arr.get_size() / 2));
+    }
+}
+BENCHMARK(BM_MappedString_Reopen)->Unit(benchmark::kMicrosecond);
+
+static void BM_MappedString_ReopenAndScan(benchmark::State& state) {
+    writeReopenFiles();
+    for (auto _ : state) {
+        MappedStringArray arr("bench_mapped");
+        arr.advise(MappedStringArray::Access::Sequential);
+        size_t bytes = 0;
+        for (size_t i = 0; i < arr.get_size(); ++i) bytes += arr.get(i).size();
+        benchmark::DoNotOptimize(bytes);
+    }
+}
+BENCHMARK(BM_MappedString_ReopenAndScan)->Unit(benchmark::kMicrosecond);
+
+static void BM_BinaryLoad_DynamicArray(benchmark::State& state) {
+    writeReopenFiles();
+    for (auto _ : state) {
+        DynamicArray<std::string> arr;
+        loadFromBinary(arr, "bench_array.bin");
+        benchmark::DoNotOptimize(arr.get_size());
+    }
+}
+BENCHMARK(BM_BinaryLoad_DynamicArray)->Unit(benchmark::kMicrosecond);
+
+// RANDOM ACCESS into large buffers with and without 2 MB huge pages.
+// 64M ints (256 MB) and a 4M-slot HashTableOpen (~300 MB) both span far
+// more 4 KB pages than the TLB covers.
+using HugeIntArray = DynamicArray<int, 0, PolicyArrayAllocator>;
+
+template <typename Array>
+static Array* fillForRandomReads(Array* arr) {
+    for (int i = 0; i < (1 << 26); ++i) arr->push_back(i);
+    return arr;
+}
+
+template <typename Array>
+static void RandomArrayReads(benchmark::State& state, const Array& arr) {
+    uint32_t x = 12345;
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < 100000; ++i) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            sum += arr[static_cast<int>(x & ((1u << 26) - 1))];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 100000);
+}
+
+static void BM_DynamicArray_RandomReads(benchmark::State& state) {
+    static DynamicArray<int>* arr = fillForRandomReads(new DynamicArray<int>(1 << 26));
+    RandomArrayReads(state, *arr);
+}
+BENCHMARK(BM_DynamicArray_RandomReads)->Unit(benchmark::kMicrosecond);
+
+static void BM_DynamicArrayHugePages_RandomReads(benchmark::State& state) {
+    static HugeIntArray* arr =
+        fillForRandomReads(new HugeIntArray(1 << 26, PolicyArrayAllocator(MemoryPolicy(true))));
+    RandomArrayReads(state, *arr);
+}
+BENCHMARK(BM_DynamicArrayHugePages_RandomReads)->Unit(benchmark::kMicrosecond);
+
+static const int kPolicyTableKeys = 1 << 21;
+
+static HashTableOpen* buildPolicyTable(const MemoryPolicy& policy) {
+    HashTableOpen* table = new HashTableOpen(1 << 22, policy);
+    for (int i = 0; i < kPolicyTableKeys; ++i) table->insert("k" + std::to_string(i), "v");
+    return table;
+}
+
+static void HashOpenRandomGets(benchmark::State& state, const HashTableOpen& table) {
+    std::mt19937 rng(5);
+    std::vector<std::string> keys(4096);
+    for (auto& key : keys) key = "k" + std::to_string(rng() % kPolicyTableKeys);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.get(keys[i++ & 4095]));
+    }
+}
+
+static void BM_HashTableOpen_RandomGets(benchmark::State& state) {
+    static HashTableOpen* table = buildPolicyTable(MemoryPolicy());
+    HashOpenRandomGets(state, *table);
+}
+BENCHMARK(BM_HashTableOpen_RandomGets);
+
+static void BM_HashTableOpenHugePages_RandomGets(benchmark::State& state) {
+    static HashTableOpen* table = buildPolicyTable(MemoryPolicy(true));
+    HashOpenRandomGets(state, *table);
+}
+BENCHMARK(BM_HashTableOpenHugePages_RandomGets);
+
+// EXTERNAL SORT of 1M short strings (~50 MB in memory as std::string).
+// Arg: memory budget in MB; 1024 keeps everything in one in-memory run.
+static void BM_ExternalSortFile(benchmark::State& state) {
+    static bool written = false;
+    if (!written) {
+        saveToBinary(unsortedSource<std::string>(1 << 20), "bench_extsort_in.bin");
+        written = true;
+    }
+    ExternalSortOptions options;
+    options.memoryBudget = static_cast<size_t>(state.range(0)) << 20;
+    int runs = 0;
+    for (auto _ : state) {
+        ExternalSorter sorter(options);
+        BinaryStringReader reader("bench_extsort_in.bin", options.ioBufferSize);
+        while (reader.next()) sorter.add(reader.value());
+        runs = sorter.get_run_count();
+        sorter.finish("bench_extsort_out.bin");
+    }
+    state.counters["runs"] = runs;
+}
+BENCHMARK(BM_ExternalSortFile)->Arg(1)->Arg(4)->Arg(16)->Arg(1024)->Unit(benchmark::kMillisecond);
+
 // 2. Benchmark: SinglyList Push Front (O(1))
 static void BM_SinglyList_PushFront(benchmark::State& state) {
     for (auto _ : state) {
@@ -43,6 +560,30 @@ static void BM_SinglyList_PushFront(benchmark::State& state) {
 }
 BENCHMARK(BM_SinglyList_PushFront)->Range(8, 1024);
 
+// Push back is O(1) through the tail pointer, so loading a list is linear.
+static void BM_SinglyList_PushBack(benchmark::State& state) {
+    for (auto _ : state) {
+        SinglyLinkedList list;
+        for (int i = 0; i < state.range(0); ++i) list.push_back("test");
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SinglyList_PushBack)->Range(8, 1 << 20);
+
+static void BM_SinglyList_LoadBinary(benchmark::State& state) {
+    SinglyLinkedList source;
+    std::vector<std::string> lines(state.range(0), "line");
+    source.append_range(lines.begin(), lines.end());
+    saveToBinary(source, "bench_singly.bin");
+    SinglyLinkedList list;
+    for (auto _ : state) {
+        loadFromBinary(list, "bench_singly.bin");
+        benchmark::DoNotOptimize(list.getTail());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SinglyList_LoadBinary)->Arg(1 << 14)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
 // 3. Benchmark: SinglyList Pop Back (O(n))
 static void BM_SinglyList_PopBack(benchmark::State& state) {
     for (auto _ : state) {
@@ -117,6 +658,360 @@ static void BM_DoublyList_InsertAfter(benchmark::State& state) {
 }
 BENCHMARK(BM_DoublyList_InsertAfter)->Range(8, 1024);
 
+// LIST INDEX BENCHMARKS
+// insert_after + delete_after at a random target of a 500K-element list
+// of distinct values; arg 1 enables the value -> node index.
+
+template <typename List>
+static void BM_ListIndexedEdit(benchmark::State& state) {
+    const int n = 500000;
+    List list;
+    std::vector<std::string> lines;
+    for (int i = 0; i < n; ++i) lines.push_back("v" + std::to_string(i));
+    for (const std::string& line : lines) list.push_back(line);
+    if (state.range(0)) list.enable_index();
+    std::mt19937 rng(9);
+    for (auto _ : state) {
+        const std::string& target = lines[rng() % n];
+        list.insert_after(target, "x");
+        list.delete_after(target);
+    }
+    state.counters["index_bytes_per_node"] = static_cast<double>(list.index_memory()) / n;
+}
+BENCHMARK_TEMPLATE(BM_ListIndexedEdit, SinglyLinkedList)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ListIndexedEdit, DoublyLinkedList)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+template <typename List>
+static void BM_ListIndexedDeleteBefore(benchmark::State& state) {
+    const int n = 500000;
+    List list;
+    std::vector<std::string> lines;
+    for (int i = 0; i < n; ++i) lines.push_back("v" + std::to_string(i));
+    for (const std::string& line : lines) list.push_back(line);
+    if (state.range(0)) list.enable_index();
+    std::mt19937 rng(9);
+    for (auto _ : state) {
+        const std::string& target = lines[1 + rng() % (n - 1)];
+        list.insert_before(target, "x");
+        list.delete_before(target);
+    }
+}
+BENCHMARK_TEMPLATE(BM_ListIndexedDeleteBefore, SinglyLinkedList)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ListIndexedDeleteBefore, DoublyLinkedList)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// LRU BENCHMARKS
+// Touch of a random key in a 50K-entry LRU order: by value (remove_value +
+// push_front), through a stored iterator (move_to_front), and std::list.
+
+static void BM_LruTouchByValue(benchmark::State& state) {
+    const int n = 50000;
+    DoublyLinkedList order;
+    for (int i = 0; i < n; ++i) order.push_back("k" + std::to_string(i));
+    std::mt19937 rng(4);
+    for (auto _ : state) {
+        std::string key = "k" + std::to_string(rng() % n);
+        order.remove_value(key);
+        order.push_front(key);
+    }
+}
+BENCHMARK(BM_LruTouchByValue)->Unit(benchmark::kMicrosecond);
+
+static void BM_LruTouchByIterator(benchmark::State& state) {
+    const int n = 50000;
+    DoublyLinkedList order;
+    std::unordered_map<std::string, DoublyLinkedList::iterator> where;
+    for (int i = 0; i < n; ++i) {
+        std::string key = "k" + std::to_string(i);
+        where[key] = order.insert(order.end(), key);
+    }
+    std::mt19937 rng(4);
+    for (auto _ : state) {
+        order.move_to_front(where.find("k" + std::to_string(rng() % n))->second);
+    }
+}
+BENCHMARK(BM_LruTouchByIterator)->Unit(benchmark::kMicrosecond);
+
+static void BM_LruTouchStdList(benchmark::State& state) {
+    const int n = 50000;
+    std::list<std::string> order;
+    std::unordered_map<std::string, std::list<std::string>::iterator> where;
+    for (int i = 0; i < n; ++i) {
+        std::string key = "k" + std::to_string(i);
+        where[key] = order.insert(order.end(), key);
+    }
+    std::mt19937 rng(4);
+    for (auto _ : state) {
+        order.splice(order.begin(), order, where.find("k" + std::to_string(rng() % n))->second);
+    }
+}
+BENCHMARK(BM_LruTouchStdList)->Unit(benchmark::kMicrosecond);
+
+// COMPACT LIST BENCHMARKS
+// Forward + backward traversal of 1M short strings. Arg 0: pushed in
+// order; 1: then 1M random elements moved to the front, so traversal order
+// no longer follows memory order; 2: shuffled, then compact().
+
+template <typename List>
+static void shuffleByMoveToFront(List& list, int n) {
+    std::vector<typename List::iterator> handles;
+    for (auto it = list.begin(); it != list.end(); ++it) handles.push_back(it);
+    std::mt19937 rng(8);
+    for (int i = 0; i < n; ++i) {
+        size_t k = rng() % handles.size();
+        std::string value = *handles[k];
+        list.erase(handles[k]);
+        handles[k] = list.insert(list.begin(), value);
+    }
+}
+
+template <typename List>
+static void BM_ListTraverse(benchmark::State& state) {
+    const int n = 1 << 20;
+    List list;
+    for (int i = 0; i < n; ++i) list.push_back(std::to_string(i));
+    if (state.range(0) >= 1) shuffleByMoveToFront(list, n);
+    if constexpr (std::is_same<List, CompactDoublyList>::value) {
+        if (state.range(0) == 2) list.compact();
+    }
+    for (auto _ : state) {
+        size_t bytes = 0;
+        for (const std::string& value : list) bytes += value.size();
+        for (auto it = list.end(); it != list.begin();) bytes += (--it)->size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+BENCHMARK_TEMPLATE(BM_ListTraverse, DoublyLinkedList)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ListTraverse, CompactDoublyList)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+// Heap bytes per element of a 1M-element list of short strings, from the
+// allocator's in-use counters, mmapped blocks and spare array capacity
+// included.
+template <typename List>
+static void BM_ListFootprint(benchmark::State& state) {
+    double perElement = 0;
+    for (auto _ : state) {
+        struct mallinfo2 start = mallinfo2();
+        size_t before = start.uordblks + start.hblkhd;
+        List list;
+        for (int i = 0; i < (1 << 20); ++i) list.push_back("v");
+        struct mallinfo2 end = mallinfo2();
+        perElement = static_cast<double>(end.uordblks + end.hblkhd - before) / (1 << 20);
+    }
+    state.counters["heap_bytes_per_element"] = perElement;
+}
+BENCHMARK_TEMPLATE(BM_ListFootprint, DoublyLinkedList)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ListFootprint, CompactDoublyList)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// LIST SORT BENCHMARKS
+// Sorting n random strings: relinking merge sort, the copy-out / std::sort
+// / rebuild workaround, and std::list::sort.
+
+static std::vector<std::string> randomKeys(int n) {
+    std::mt19937 rng(12);
+    std::vector<std::string> keys;
+    for (int i = 0; i < n; ++i) keys.push_back("key" + std::to_string(rng()));
+    return keys;
+}
+
+template <typename List>
+static void BM_ListSortInPlace(benchmark::State& state) {
+    std::vector<std::string> keys = randomKeys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        List list;
+        for (const std::string& key : keys) list.push_back(key);
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(list.getHead());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ListSortInPlace, SinglyLinkedList)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ListSortInPlace, DoublyLinkedList)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_ListSortCopyOut(benchmark::State& state) {
+    std::vector<std::string> keys = randomKeys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        SinglyLinkedList list;
+        for (const std::string& key : keys) list.push_back(key);
+        state.ResumeTiming();
+        std::vector<std::string> values;
+        for (FNode* node = list.getHead(); node; node = node->next) values.push_back(node->key);
+        std::sort(values.begin(), values.end());
+        list.clear();
+        for (const std::string& value : values) list.push_back(value);
+        benchmark::DoNotOptimize(list.getHead());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ListSortCopyOut)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_StdListSort(benchmark::State& state) {
+    std::vector<std::string> keys = randomKeys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::list<std::string> list(keys.begin(), keys.end());
+        state.ResumeTiming();
+        list.sort();
+        benchmark::DoNotOptimize(list.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdListSort)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// LIST BATCH FIND BENCHMARKS
+// k lookups of present values in a sorted list of n random strings; sorting
+// relinks the nodes, so consecutive nodes are scattered in memory.
+// Mode 0: k find() calls, 1: find_many, 2: find_many without prefetching.
+
+static void BM_ListFindMany(benchmark::State& state) {
+    int n = state.range(0);
+    int k = state.range(1);
+    std::vector<std::string> keys = randomKeys(n);
+    SinglyLinkedList list(NodeAllocator::pool());
+    for (const std::string& key : keys) list.push_back(key);
+    list.sort();
+    std::mt19937 rng(14);
+    std::vector<std::string_view> queries;
+    for (int i = 0; i < k; ++i) queries.push_back(keys[rng() % n]);
+    std::vector<FNode*> found(k);
+    for (auto _ : state) {
+        if (state.range(2) == 0) {
+            for (int i = 0; i < k; ++i) found[i] = list.find(std::string(queries[i]));
+        } else if (state.range(2) == 1) {
+            found = list.find_many(queries);
+        } else {
+            findManyInChain<FNode, &FNode::key, 0>(list.getHead(), queries.data(), k, found.data());
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * k);
+}
+BENCHMARK(BM_ListFindMany)
+    ->ArgsProduct({{1 << 12, 1 << 18}, {1, 16, 256}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+// UNROLLED LIST BENCHMARKS
+// Full scans (find of a missing value) over n short strings.
+
+template <typename List>
+static void BM_ListFindMissing(benchmark::State& state) {
+    List list;
+    std::mt19937 rng(3);
+    for (int i = 0; i < state.range(0); ++i) list.push_back(std::to_string(rng() % 100000000));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(list.find("missing"));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ListFindMissing, DoublyLinkedList)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListFindMissing, UnrolledLinkedList<4>)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ListFindMissing, UnrolledLinkedList<8>)->Range(1 << 10, 1 << 18);
+
+// Inserts at a random existing value: a scan plus an in-block shift.
+template <typename List>
+static void BM_ListInsertAfter(benchmark::State& state) {
+    List list;
+    for (int i = 0; i < state.range(0); ++i) list.push_back(std::to_string(i));
+    std::mt19937 rng(5);
+    for (auto _ : state) {
+        list.insert_after(std::to_string(rng() % state.range(0)), "new");
+    }
+}
+BENCHMARK_TEMPLATE(BM_ListInsertAfter, DoublyLinkedList)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(BM_ListInsertAfter, UnrolledLinkedList<4>)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(BM_ListInsertAfter, UnrolledLinkedList<8>)->Arg(1 << 14);
+
+// SKIP LIST BENCHMARKS
+// Ordered string sets: skip list, its concurrent variant and std::set; the
+// doubly linked list's linear find as the baseline for lookups.
+
+static bool setInsert(std::set<std::string>& set, const std::string& key) { return set.insert(key).second; }
+static bool setInsert(DoublyLinkedList& list, const std::string& key) {
+    list.push_back(key);
+    return true;
+}
+template <typename Set>
+static bool setInsert(Set& set, const std::string& key) { return set.insert(key); }
+
+static bool setContains(const std::set<std::string>& set, const std::string& key) { return set.count(key) != 0; }
+static bool setContains(const DoublyLinkedList& list, const std::string& key) { return list.find(key) != nullptr; }
+template <typename Set>
+static bool setContains(const Set& set, const std::string& key) { return set.contains(key); }
+
+template <typename Set>
+static void BM_SetInsert(benchmark::State& state) {
+    std::vector<std::string> keys = randomKeys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            Set set;
+            state.ResumeTiming();
+            for (const std::string& key : keys) setInsert(set, key);
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SetInsert, SkipListSet)->Arg(1 << 12)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SetInsert, ConcurrentSkipListSet)->Arg(1 << 12)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SetInsert, std::set<std::string>)->Arg(1 << 12)->Arg(1 << 17)->Unit(benchmark::kMicrosecond);
+
+// Lookups of present keys in random order.
+template <typename Set>
+static void BM_SetContains(benchmark::State& state) {
+    std::vector<std::string> keys = randomKeys(state.range(0));
+    Set set;
+    for (const std::string& key : keys) setInsert(set, key);
+    std::mt19937 rng(13);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(setContains(set, keys[i]));
+        if (++i == keys.size()) i = 0;
+    }
+}
+BENCHMARK_TEMPLATE(BM_SetContains, SkipListSet)->Arg(1 << 12)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(BM_SetContains, ConcurrentSkipListSet)->Arg(1 << 12)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(BM_SetContains, std::set<std::string>)->Arg(1 << 12)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(BM_SetContains, DoublyLinkedList)->Arg(1 << 12);
+
+// In-order walk of every key.
+template <typename Set>
+static void BM_SetIterate(benchmark::State& state) {
+    Set set;
+    for (const std::string& key : randomKeys(state.range(0))) setInsert(set, key);
+    for (auto _ : state) {
+        size_t bytes = 0;
+        for (const std::string& key : set) bytes += key.size();
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SetIterate, SkipListSet)->Arg(1 << 17);
+BENCHMARK_TEMPLATE(BM_SetIterate, std::set<std::string>)->Arg(1 << 17);
+
+// Threads inserting disjoint keys into one shared set.
+static ConcurrentSkipListSet* benchSharedSkip = nullptr;
+
+static void BM_ConcurrentSkipInsert(benchmark::State& state) {
+    if (state.thread_index() == 0) benchSharedSkip = new ConcurrentSkipListSet();
+    std::string prefix = "t" + std::to_string(state.thread_index()) + "-";
+    uint64_t seed = state.thread_index();
+    for (auto _ : state) {
+        benchSharedSkip->insert(prefix + std::to_string(skipRandom(seed)));
+    }
+    if (state.thread_index() == 0) {
+        delete benchSharedSkip;
+        benchSharedSkip = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConcurrentSkipInsert)->Threads(1)->Threads(4)->UseRealTime();
+
 // STACK BENCHMARKS
 
 static void BM_MyStack_Push(benchmark::State& state) {
@@ -170,4 +1065,214 @@ static void BM_StdQueue_Push(benchmark::State& state) {
 }
 BENCHMARK(BM_StdQueue_Push)->Range(8, 4096);
 
+// Same traffic as BM_QueueChurn for std::queue (a std::deque).
+static void BM_StdQueueChurn(benchmark::State& state) {
+    std::queue<std::string> q;
+    for (int i = 0; i < 1024; ++i) q.push("data");
+    for (auto _ : state) {
+        q.push("data");
+        benchmark::DoNotOptimize(q.front());
+        q.pop();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdQueueChurn);
+
+// 256 strings in and out per iteration: one push / try_pop per element
+// (arg 0) or push_range / pop_n (arg 1).
+static void BM_QueueBatch(benchmark::State& state) {
+    std::vector<std::string> batch(256, kLongString);
+    std::vector<std::string> out(256);
+    Queue q;
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            for (const std::string& v : batch) q.push(v);
+            for (std::string& v : out) q.try_pop(v);
+        } else {
+            q.push_range(batch.begin(), batch.end());
+            q.pop_n(out.size(), out.begin());
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_QueueBatch)->Arg(0)->Arg(1);
+
+// NODE POOL CHURN BENCHMARKS
+// Steady push/pop traffic over a standing backlog of 1024 items; arg 0 is
+// plain new/delete, 1 the slab pool, 2 the pool on a pmr resource.
+
+static NodeAllocator churnAllocator(int mode, std::pmr::memory_resource* resource) {
+    if (mode == 0) return NodeAllocator::heap();
+    return NodeAllocator::pool(mode == 2 ? resource : nullptr);
+}
+
+static void BM_QueueChurn(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource resource;
+    Queue q(churnAllocator(static_cast<int>(state.range(0)), &resource));
+    for (int i = 0; i < 1024; ++i) q.push("data");
+    for (auto _ : state) {
+        q.push("data");
+        benchmark::DoNotOptimize(q.pop());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueueChurn)->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_StackChurn(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource resource;
+    Stack s(churnAllocator(static_cast<int>(state.range(0)), &resource));
+    for (auto _ : state) {
+        for (int i = 0; i < 64; ++i) s.push("data");
+        for (int i = 0; i < 64; ++i) benchmark::DoNotOptimize(s.pop());
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_StackChurn)->Arg(0)->Arg(1)->Arg(2);
+
+// Fill then clear: per-node delete against one bulk slab release.
+static void BM_DoublyListFillClear(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource resource;
+    DoublyLinkedList list(churnAllocator(static_cast<int>(state.range(0)), &resource));
+    for (auto _ : state) {
+        for (int i = 0; i < 4096; ++i) list.push_back("data");
+        list.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_DoublyListFillClear)->Arg(0)->Arg(1)->Arg(2);
+
+// FROZEN SEARCH LAYOUT BENCHMARKS
+// 4K, 128K, 2M and 8M int keys: roughly L1, L2, LLC and DRAM resident.
+
+static const std::vector<int>& benchSortedKeys(int n) {
+    static std::map<int, std::vector<int>> cache;
+    auto& keys = cache[n];
+    if (keys.empty()) {
+        for (int i = 0; i < n; ++i) keys.push_back(i * 2);
+    }
+    return keys;
+}
+
+static const BinarySearchTree<>& benchTree(int n) {
+    static std::map<int, std::unique_ptr<BinarySearchTree<>>> cache;
+    auto& tree = cache[n];
+    if (!tree) {
+        tree.reset(new BinarySearchTree<>());
+        std::vector<int> keys = benchSortedKeys(n);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+        for (int key : keys) tree->insert(key);
+    }
+    return *tree;
+}
+
+static std::vector<int> benchQueries(int n) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 2 * n);
+    std::vector<int> queries(1 << 16);
+    for (auto& q : queries) q = dist(rng);
+    return queries;
+}
+
+static void BM_BST_Contains(benchmark::State& state) {
+    const BinarySearchTree<>& tree = benchTree(state.range(0));
+    std::vector<int> queries = benchQueries(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.contains(queries[i++ & 0xFFFF]));
+    }
+}
+BENCHMARK(BM_BST_Contains)->Arg(1 << 12)->Arg(1 << 17)->Arg(1 << 21)->Arg(1 << 23);
+
+static void BM_StdLowerBound(benchmark::State& state) {
+    const std::vector<int>& keys = benchSortedKeys(state.range(0));
+    std::vector<int> queries = benchQueries(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(keys.begin(), keys.end(), queries[i++ & 0xFFFF]));
+    }
+}
+BENCHMARK(BM_StdLowerBound)->Arg(1 << 12)->Arg(1 << 17)->Arg(1 << 21)->Arg(1 << 23);
+
+static void BM_Eytzinger_Contains(benchmark::State& state) {
+    EytzingerTree eyt;
+    eyt.build(benchSortedKeys(state.range(0)));
+    std::vector<int> queries = benchQueries(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(eyt.contains(queries[i++ & 0xFFFF]));
+    }
+}
+BENCHMARK(BM_Eytzinger_Contains)->Arg(1 << 12)->Arg(1 << 17)->Arg(1 << 21)->Arg(1 << 23);
+
+static void BM_BlockedEytzinger_Contains(benchmark::State& state) {
+    BlockedEytzingerTree blocked;
+    blocked.build(benchSortedKeys(state.range(0)));
+    std::vector<int> queries = benchQueries(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(blocked.contains(queries[i++ & 0xFFFF]));
+    }
+}
+BENCHMARK(BM_BlockedEytzinger_Contains)->Arg(1 << 12)->Arg(1 << 17)->Arg(1 << 21)->Arg(1 << 23);
+
+// BST SET OPERATION BENCHMARKS
+// Args: size of the first tree, size of the second tree, threads.
+
+static void benchFillTree(BinarySearchTree<>& tree, int n, int stride, unsigned seed) {
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = i * stride;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(seed));
+    for (int key : keys) tree.insert(key);
+}
+
+static void BM_BST_IntersectNaive(benchmark::State& state) {
+    BinarySearchTree<> a, b;
+    benchFillTree(a, state.range(0), 3, 1);
+    benchFillTree(b, state.range(1), 2, 2);
+    for (auto _ : state) {
+        std::vector<int> result;
+        for (int key : a) {
+            if (b.contains(key)) result.push_back(key);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_BST_IntersectNaive)->Args({1 << 8, 1 << 18})->Args({1 << 16, 1 << 16})->Unit(benchmark::kMicrosecond);
+
+static void BM_BST_IntersectWith(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        BinarySearchTree<> a, b;
+        benchFillTree(a, state.range(0), 3, 1);
+        benchFillTree(b, state.range(1), 2, 2);
+        state.ResumeTiming();
+        a.intersect_with(std::move(b), state.range(2));
+        benchmark::DoNotOptimize(a.getRoot());
+    }
+}
+BENCHMARK(BM_BST_IntersectWith)
+    ->Args({1 << 4, 1 << 10, 1})->Args({1 << 4, 1 << 10, 4})
+    ->Args({1 << 8, 1 << 18, 1})->Args({1 << 16, 1 << 16, 1})->Args({1 << 16, 1 << 16, 4})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_BST_UnionWith(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        BinarySearchTree<> a, b;
+        benchFillTree(a, state.range(0), 3, 1);
+        benchFillTree(b, state.range(1), 2, 2);
+        state.ResumeTiming();
+        a.union_with(std::move(b), state.range(2));
+        benchmark::DoNotOptimize(a.getRoot());
+        state.PauseTiming();
+        a.clear();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_BST_UnionWith)
+    ->Args({1 << 4, 1 << 10, 1})->Args({1 << 4, 1 << 10, 4})
+    ->Args({1 << 8, 1 << 18, 1})->Args({1 << 16, 1 << 16, 1})->Args({1 << 16, 1 << 16, 4})
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
\ No newline at end of file
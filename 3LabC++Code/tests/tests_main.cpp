@@ -8,16 +8,33 @@
 #include <unordered_set>
 #include <string>
 #include <algorithm>
+#include <memory>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <string_view>
+#include <memory_resource>
 
 #include "DynamicArray.h"
+#include "StringPoolArray.h"
+#include "GapBufferArray.h"
+#include "SegmentedArray.h"
+#include "SortedArraySet.h"
 #include "SinglyList.h"
 #include "DoublyList.h"
+#include "UnrolledList.h"
+#include "CompactList.h"
+#include "SkipList.h"
 #include "Stack.h"
 #include "Queue.h"
 #include "HashTable.h"
 #include "HashTableOpen.h"
 #include "BinarySearchTree.h"
 #include "Serialization.h"
+#include "MappedArray.h"
+#include "ExternalSort.h"
+#include "EytzingerTree.h"
+#include "PersistentTree.h"
 
 using namespace std;
 
@@ -111,6 +128,476 @@ TEST(DynamicArrayTest, RandomStress) {
     EXPECT_EQ(myArr.get_size(), 0);
 }
 
+TEST(DynamicArrayTest, TemplatedAndMoveOnly) {
+    DynamicArray<int> ints(1);
+    for (int i = 0; i < 100; ++i) ints.push_back(i);
+    ints.insert(0, -1);
+    ints.remove_at(50);
+    EXPECT_EQ(ints.get_size(), 100);
+    EXPECT_EQ(ints.get(0), -1);
+    EXPECT_EQ(ints.get(50), 50);
+    EXPECT_EQ(ints.get(1000), 0);
+
+    DynamicArray<unique_ptr<string>> owners;
+    for (int i = 0; i < 10; ++i) owners.emplace_back(new string(to_string(i)));
+    owners.insert(5, unique_ptr<string>(new string("mid")));
+    owners.remove_at(0);
+    EXPECT_EQ(owners.get_size(), 10);
+}
+
+struct CopyCounter {
+    static int copies;
+    int value;
+    CopyCounter(int v = 0) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { copies++; }
+    CopyCounter(CopyCounter&& other) noexcept : value(other.value) {}
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; copies++; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; return *this; }
+};
+int CopyCounter::copies = 0;
+
+TEST(DynamicArrayTest, GrowthAndShiftsMoveElements) {
+    CopyCounter::copies = 0;
+    DynamicArray<CopyCounter> arr;
+    for (int i = 0; i < 1000; ++i) arr.emplace_back(i);
+    arr.insert(0, CopyCounter(-1));
+    arr.remove_at(10);
+    arr.reserve(5000);
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(arr.get_capacity(), 5000);
+    EXPECT_EQ(arr.get(0).value, -1);
+    EXPECT_EQ(arr.get(10).value, 10);
+
+    DynamicArray<CopyCounter> copy(arr);
+    EXPECT_EQ(copy.get_size(), 1000);
+    DynamicArray<CopyCounter> moved(std::move(copy));
+    EXPECT_EQ(moved.get_size(), 1000);
+    EXPECT_EQ(copy.get_size(), 0);
+    copy = moved;
+    EXPECT_EQ(copy.get(999).value, 999);
+}
+
+// Counts the heap buffers DynamicArrays take.
+static int arrayAllocations = 0;
+
+struct CountingArrayAllocator {
+    void* allocate(size_t bytes) const {
+        arrayAllocations++;
+        return ::operator new(bytes);
+    }
+    void deallocate(void* p, size_t) const { ::operator delete(p); }
+};
+
+TEST(DynamicArrayTest, SmallBufferBelowDefaultCapacity) {
+    arrayAllocations = 0;
+    DynamicArray<int, 2, CountingArrayAllocator> tiny;
+    EXPECT_EQ(tiny.get_capacity(), 2);
+    DynamicArray<int, 1, CountingArrayAllocator> one;
+    EXPECT_EQ(one.get_capacity(), 1);
+    tiny.push_back(1);
+    tiny.push_back(2);
+    EXPECT_EQ(arrayAllocations, 0);
+    DynamicArray<int, 2, CountingArrayAllocator> empty(0);
+    EXPECT_EQ(empty.get_capacity(), 2);
+    EXPECT_EQ(arrayAllocations, 0);
+    tiny.push_back(3);
+    EXPECT_EQ(arrayAllocations, 1);
+    EXPECT_EQ(tiny.get(2), 3);
+    DynamicArray<int> plain;
+    EXPECT_EQ(plain.get_capacity(), 4);
+}
+
+TEST(DynamicArrayTest, SmallBufferInlineAndSpill) {
+    DynamicArray<int, 8> small;
+    EXPECT_EQ(small.get_capacity(), 8);
+    EXPECT_GE(sizeof(small), 8 * sizeof(int));
+    for (int i = 0; i < 8; ++i) small.push_back(i);
+    EXPECT_EQ(small.get_capacity(), 8);
+
+    // Moving an inline array relocates its elements; the source stays usable.
+    DynamicArray<int, 8> movedInline(std::move(small));
+    EXPECT_EQ(movedInline.get(7), 7);
+    EXPECT_EQ(small.get_size(), 0);
+    small.push_back(42);
+    EXPECT_EQ(small.get(0), 42);
+
+    for (int i = 8; i < 100; ++i) movedInline.push_back(i);
+    EXPECT_EQ(movedInline.get_capacity(), 128);
+    movedInline.insert(0, -1);
+    EXPECT_EQ(movedInline.get(100), 99);
+
+    DynamicArray<int, 8> copy(movedInline);
+    EXPECT_EQ(copy.get_size(), 101);
+    small = copy;
+    EXPECT_EQ(small.get(50), 49);
+    small = DynamicArray<int, 8>();
+    EXPECT_EQ(small.get_size(), 0);
+    EXPECT_EQ(small.get_capacity(), 8);
+
+    DynamicArray<string, 4> names;
+    names.push_back("a long string that does not fit into the SSO buffer");
+    names.push_back("b");
+    DynamicArray<string, 4> heapNames(std::move(names));
+    for (int i = 0; i < 10; ++i) heapNames.push_back(to_string(i));
+    names = std::move(heapNames);
+    EXPECT_EQ(names.get_size(), 12);
+    EXPECT_EQ(names.get(1), "b");
+    EXPECT_EQ(heapNames.get_size(), 0);
+    heapNames.push_back("reused");
+    EXPECT_EQ(heapNames.get(0), "reused");
+
+    DynamicArray<int> plain;
+    DynamicArray<int> stolen(std::move(plain));
+    plain.push_back(1);
+    EXPECT_EQ(plain.get(0), 1);
+}
+
+template <typename T>
+void checkIntegerScans() {
+    for (int n : {0, 1, 7, 31, 32, 33, 100, 1000}) {
+        DynamicArray<T> arr;
+        vector<T> ref;
+        for (int i = 0; i < n; ++i) {
+            T v = static_cast<T>(gen() % 5);
+            arr.push_back(v);
+            ref.push_back(v);
+        }
+        for (int v = 0; v < 6; ++v) {
+            T x = static_cast<T>(v);
+            auto it = std::find(ref.begin(), ref.end(), x);
+            ASSERT_EQ(arr.find(x), it == ref.end() ? -1 : (int)(it - ref.begin()));
+            ASSERT_EQ(arr.count(x), (int)std::count(ref.begin(), ref.end(), x));
+            if (n > 3) {
+                auto tail = std::find(ref.begin() + 3, ref.end(), x);
+                ASSERT_EQ(arr.find(x, 3), tail == ref.end() ? -1 : (int)(tail - ref.begin()));
+            }
+        }
+        DynamicArray<T> missing;
+        missing.push_back(static_cast<T>(7));
+        missing.push_back(static_cast<T>(-1));
+        EXPECT_FALSE(arr.contains_any(missing));
+        missing.push_back(static_cast<T>(4));
+        EXPECT_EQ(arr.contains_any(missing), std::find(ref.begin(), ref.end(), T(4)) != ref.end());
+    }
+}
+
+TEST(DynamicArrayTest, FindCountContainsAny) {
+    checkIntegerScans<char>();
+    checkIntegerScans<short>();
+    checkIntegerScans<int>();
+    checkIntegerScans<long long>();
+
+    DynamicArray<int> big;
+    for (int i = 0; i < 1000; ++i) big.push_back(i);
+    EXPECT_EQ(big.find(999), 999);
+    EXPECT_EQ(big.find(5, 6), -1);
+    EXPECT_EQ(big.find(5, 5000), -1);
+
+    DynamicArray<string> words;
+    string longWord(70, 'x');
+    for (string w : {string("apple"), string("apricot"), string("banana"), string("apple"), string(), longWord}) words.push_back(w);
+    EXPECT_EQ(words.find("apple"), 0);
+    EXPECT_EQ(words.find("apple", 1), 3);
+    EXPECT_EQ(words.find(longWord), 5);
+    EXPECT_EQ(words.find(string(70, 'y')), -1);
+    EXPECT_EQ(words.count("apple"), 2);
+    EXPECT_EQ(words.count(""), 1);
+    EXPECT_EQ(words.find_prefix("ap", 1), 1);
+    EXPECT_EQ(words.find_prefix("ba"), 2);
+    EXPECT_EQ(words.count_prefix("ap"), 3);
+    EXPECT_EQ(words.count_prefix(""), 6);
+    EXPECT_EQ(words.count_prefix(string(40, 'x')), 1);
+    DynamicArray<string> needles;
+    needles.push_back("cherry");
+    EXPECT_FALSE(words.contains_any(needles));
+    needles.push_back("banana");
+    EXPECT_TRUE(words.contains_any(needles));
+}
+
+TEST(DynamicArrayTest, SortUniqueLowerBound) {
+    for (unsigned threads : {1u, 4u}) {
+        DynamicArray<int> ints;
+        vector<int> ref;
+        for (int i = 0; i < 100000; ++i) {
+            int v = gen() % 20000 - 10000;
+            ints.push_back(v);
+            ref.push_back(v);
+        }
+        ints.sort(threads);
+        std::sort(ref.begin(), ref.end());
+        for (int i = 0; i < ints.get_size(); ++i) ASSERT_EQ(ints[i], ref[i]);
+        EXPECT_EQ(ints.lower_bound(17), (int)(std::lower_bound(ref.begin(), ref.end(), 17) - ref.begin()));
+        EXPECT_EQ(ints.lower_bound(1 << 20), ints.get_size());
+        ref.erase(std::unique(ref.begin(), ref.end()), ref.end());
+        EXPECT_EQ(ints.unique(), (int)ref.size());
+        for (int i = 0; i < ints.get_size(); ++i) ASSERT_EQ(ints[i], ref[i]);
+
+        // Shared prefixes, empty strings and long runs exercise every radix path.
+        DynamicArray<string> strs;
+        vector<string> sref;
+        for (int i = 0; i < 50000; ++i) {
+            string v = (i % 5 == 0 ? string(80, 'p') : string()) + randomString(gen() % 4);
+            if (i % 7 == 0) v.push_back('\0');
+            strs.push_back(v);
+            sref.push_back(v);
+        }
+        strs.sort(threads);
+        std::sort(sref.begin(), sref.end());
+        for (int i = 0; i < strs.get_size(); ++i) ASSERT_EQ(strs[i], sref[i]);
+    }
+
+    DynamicArray<string> empty;
+    empty.sort();
+    EXPECT_EQ(empty.unique(), 0);
+    EXPECT_EQ(empty.lower_bound("a"), 0);
+}
+
+TEST(SortedArraySetTest, OrderedInsertAndBulkBuild) {
+    SortedArraySet<int> set;
+    std::set<int> ref;
+    for (int i = 0; i < 5000; ++i) {
+        int v = gen() % 1000;
+        if (gen() % 3) {
+            ASSERT_EQ(set.insert(v), ref.insert(v).second);
+        } else {
+            ASSERT_EQ(set.remove(v), ref.erase(v) == 1);
+        }
+    }
+    ASSERT_EQ(set.get_size(), (int)ref.size());
+    int i = 0;
+    for (int v : ref) ASSERT_EQ(set[i++], v);
+    EXPECT_EQ(set.index_of(-1), -1);
+    EXPECT_FALSE(set.contains(1000));
+
+    DynamicArray<string> words;
+    for (string w : {"pear", "apple", "fig", "apple", "kiwi", "fig"}) words.push_back(w);
+    SortedArraySet<string> bulk(std::move(words), 2);
+    EXPECT_EQ(bulk.get_size(), 4);
+    EXPECT_EQ(bulk.get(0), "apple");
+    EXPECT_EQ(bulk.index_of("kiwi"), 2);
+    EXPECT_EQ(bulk.lower_bound("b"), 1);
+    EXPECT_TRUE(bulk.insert("banana"));
+    EXPECT_FALSE(bulk.insert("banana"));
+    EXPECT_EQ(bulk.get(1), "banana");
+}
+
+TEST(GapBufferArrayTest, CursorEdits) {
+    GapBufferArray<string> arr;
+    EXPECT_EQ(arr.get(0), "");
+    arr.remove_at(0);
+    arr.insert(1, "fail");
+    EXPECT_EQ(arr.get_size(), 0);
+
+    for (int i = 0; i < 10; ++i) arr.push_back(to_string(i));
+    arr.insert(3, "a");
+    arr.insert(4, "b");
+    EXPECT_EQ(arr.get_gap_position(), 5);
+    arr.remove_at(4);
+    arr.insert(0, arr.get(9));
+    arr.set(1, "zero");
+    EXPECT_EQ(arr.get_size(), 12);
+    EXPECT_EQ(arr.get(0), "8");
+    EXPECT_EQ(arr.get(1), "zero");
+    EXPECT_EQ(arr.get(4), "a");
+    EXPECT_EQ(arr.get(11), "9");
+
+    GapBufferArray<string> copy(arr);
+    GapBufferArray<string> moved(std::move(arr));
+    EXPECT_EQ(arr.get_size(), 0);
+    arr.push_back("again");
+    EXPECT_EQ(arr.get(0), "again");
+    for (int i = 0; i < copy.get_size(); ++i) EXPECT_EQ(copy[i], moved[i]);
+
+    GapBufferArray<unique_ptr<int>> owners;
+    for (int i = 0; i < 20; ++i) owners.insert(i / 2, unique_ptr<int>(new int(i)));
+    owners.remove_at(0);
+    EXPECT_EQ(owners.get_size(), 19);
+}
+
+TEST(GapBufferArrayTest, RandomStress) {
+    GapBufferArray<string> arr;
+    vector<string> ref;
+    int cursor = 0;
+    uniform_int_distribution<> step(-3, 3);
+    uniform_int_distribution<> op(0, 9);
+    for (int i = 0; i < 20000; ++i) {
+        cursor = max(0, min<int>(ref.size(), cursor + step(gen)));
+        if (op(gen) == 0) cursor = gen() % (ref.size() + 1);
+        int o = op(gen);
+        if (o < 5) {
+            string s = randomString(1 + gen() % 30);
+            arr.insert(cursor, s);
+            ref.insert(ref.begin() + cursor, s);
+        } else if (o < 8 && cursor < (int)ref.size()) {
+            arr.remove_at(cursor);
+            ref.erase(ref.begin() + cursor);
+        } else if (cursor < (int)ref.size()) {
+            string s = randomString(5);
+            arr.set(cursor, s);
+            ref[cursor] = s;
+        }
+        ASSERT_EQ(arr.get_size(), (int)ref.size());
+    }
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(arr.get(i), ref[i]);
+    arr.clear();
+    EXPECT_EQ(arr.get_size(), 0);
+}
+
+TEST(SegmentedArrayTest, StableAddressesAcrossGrowth) {
+    SegmentedArray<string, 4> arr;
+    EXPECT_EQ(arr.get(0), "");
+    arr.remove_at(0);
+    arr.pop_back();
+    arr.insert(1, "fail");
+    EXPECT_EQ(arr.get_size(), 0);
+
+    arr.push_back("first");
+    const string* first = &arr[0];
+    for (int i = 1; i < 1000; ++i) arr.push_back(arr[i - 1] + "");
+    EXPECT_EQ(first, &arr[0]);
+    EXPECT_EQ(*first, "first");
+    EXPECT_EQ(arr.get_capacity(), 1008);
+
+    arr.insert(0, "zero");
+    arr.remove_at(500);
+    arr.set(1, "one");
+    EXPECT_EQ(arr.get_size(), 1000);
+    EXPECT_EQ(arr.get(0), "zero");
+    EXPECT_EQ(arr.get(1), "one");
+
+    SegmentedArray<string, 4> copy(arr);
+    SegmentedArray<string, 4> moved(std::move(arr));
+    EXPECT_EQ(arr.get_size(), 0);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(copy[i], moved[i]);
+    moved.clear();
+    moved.push_back("x");
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.get_capacity(), 16);
+
+    SegmentedArray<unique_ptr<int>, 2> owners;
+    for (int i = 0; i < 20; ++i) owners.emplace_back(new int(i));
+    owners.insert(3, unique_ptr<int>(new int(-1)));
+    owners.remove_at(0);
+    EXPECT_EQ(*owners[2], -1);
+}
+
+TEST(SegmentedArrayTest, RandomStress) {
+    SegmentedArray<int, 3> arr;
+    vector<int> ref;
+    for (int i = 0; i < 5000; ++i) {
+        int op = gen() % 4;
+        int idx = ref.empty() ? 0 : gen() % ref.size();
+        if (op < 2) {
+            arr.push_back(i);
+            ref.push_back(i);
+        } else if (op == 2) {
+            arr.insert(idx, i);
+            ref.insert(ref.begin() + idx, i);
+        } else if (!ref.empty()) {
+            arr.remove_at(idx);
+            ref.erase(ref.begin() + idx);
+        }
+        ASSERT_EQ(arr.get_size(), (int)ref.size());
+    }
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(arr.get(i), ref[i]);
+}
+
+TEST(StringPoolArrayTest, BasicAndCompaction) {
+    StringPoolArray arr;
+    EXPECT_EQ(arr.get(0), "");
+    arr.remove_at(0);
+    arr.insert(5, "fail");
+    EXPECT_EQ(arr.get_size(), 0);
+
+    arr.push_back("alpha");
+    arr.push_back("beta");
+    arr.insert(1, "gamma");
+    arr.push_back(arr.get(0));
+    EXPECT_EQ(arr.get_size(), 4);
+    EXPECT_EQ(arr.get(1), "gamma");
+    EXPECT_EQ(arr.get(3), "alpha");
+
+    arr.set(0, "a");
+    arr.set(2, "a much longer replacement value");
+    arr.set(1, arr.get(2));
+    arr.remove_at(3);
+    EXPECT_GT(arr.get_garbage(), 0u);
+    arr.compact();
+    EXPECT_EQ(arr.get_garbage(), 0u);
+    EXPECT_EQ(arr.get(0), "a");
+    EXPECT_EQ(arr.get(1), "a much longer replacement value");
+    EXPECT_EQ(arr.get(2), "a much longer replacement value");
+
+    DynamicArray<string> source;
+    source.push_back("x");
+    source.push_back("yz");
+    arr.append(source);
+    EXPECT_EQ(arr.get(4), "yz");
+    arr.clear();
+    EXPECT_EQ(arr.get_size(), 0);
+}
+
+TEST(StringPoolArrayTest, FindCountAndPrefix) {
+    StringPoolArray arr;
+    DynamicArray<string> ref;
+    for (int i = 0; i < 3000; ++i) {
+        string s = (i % 3 ? "key" : "val") + to_string(gen() % 50) + string(i % 7 == 0 ? 200 : 0, '#');
+        arr.push_back(s);
+        ref.push_back(s);
+    }
+    arr.set(10, "replaced");
+    ref.set(10, "replaced");
+    // Second pass scans the compacted, in-order blob.
+    for (int pass = 0; pass < 2; ++pass) {
+        for (string probe : {string("key7"), string("val12"), string("replaced"), string("missing"), "key7" + string(200, '#')}) {
+            EXPECT_EQ(arr.find(probe), ref.find(probe));
+            EXPECT_EQ(arr.find(probe, 100), ref.find(probe, 100));
+            EXPECT_EQ(arr.count(probe), ref.count(probe));
+        }
+        EXPECT_EQ(arr.count_prefix("key"), ref.count_prefix("key"));
+        arr.compact();
+    }
+    EXPECT_EQ(arr.find_prefix("rep"), 10);
+    EXPECT_EQ(arr.find_prefix("zzz"), -1);
+    DynamicArray<string> needles;
+    needles.push_back("absent");
+    EXPECT_FALSE(arr.contains_any(needles));
+    needles.push_back("replaced");
+    EXPECT_TRUE(arr.contains_any(needles));
+}
+
+TEST(StringPoolArrayTest, RandomStress) {
+    StringPoolArray arr;
+    vector<string> stdVec;
+    uniform_int_distribution<> opDist(0, 4);
+    uniform_int_distribution<> lenDist(0, 40);
+
+    for (int i = 0; i < 5000; ++i) {
+        int op = opDist(gen);
+        string val = randomString(lenDist(gen));
+        int idx = stdVec.empty() ? 0 : rand() % stdVec.size();
+        if (op == 0) {
+            arr.push_back(val);
+            stdVec.push_back(val);
+        } else if (op == 1) {
+            arr.insert(idx, val);
+            stdVec.insert(stdVec.begin() + idx, val);
+        } else if (op == 2 && !stdVec.empty()) {
+            arr.remove_at(idx);
+            stdVec.erase(stdVec.begin() + idx);
+        } else if (op == 3 && !stdVec.empty()) {
+            arr.set(idx, val);
+            stdVec[idx] = val;
+        } else if (!stdVec.empty()) {
+            EXPECT_EQ(arr.get(idx), stdVec[idx]);
+        }
+    }
+    ASSERT_EQ(arr.get_size(), (int)stdVec.size());
+    for (size_t i = 0; i < stdVec.size(); ++i) {
+        EXPECT_EQ(arr.get(i), stdVec[i]);
+    }
+}
+
 // 2. SINGLY LINKED LIST TESTS
 
 TEST(SinglyListTest, BasicAndEdge) {
@@ -205,6 +692,129 @@ TEST(SinglyListTest, RandomStress) {
     list.clear();
 }
 
+// One random value-based edit applied to list and mirrored on ref; values
+// are drawn from [0, distinct) so duplicates are common. Returns the
+// target value used.
+template <typename List>
+static string randomListEdit(List& list, std::list<string>& ref, int distinct) {
+    string val = to_string(gen() % distinct);
+    string target = to_string(gen() % distinct);
+    auto at = std::find(ref.begin(), ref.end(), target);
+    switch (gen() % 9) {
+        case 0: list.push_front(val); ref.push_front(val); break;
+        case 1: list.push_back(val); ref.push_back(val); break;
+        case 2: list.pop_front(); if (!ref.empty()) ref.pop_front(); break;
+        case 3: list.pop_back(); if (!ref.empty()) ref.pop_back(); break;
+        case 4:
+            list.remove_value(target);
+            if (at != ref.end()) ref.erase(at);
+            break;
+        case 5:
+            EXPECT_EQ(list.insert_after(target, val), at != ref.end());
+            if (at != ref.end()) ref.insert(std::next(at), val);
+            break;
+        case 6:
+            EXPECT_EQ(list.insert_before(target, val), at != ref.end());
+            if (at != ref.end()) ref.insert(at, val);
+            break;
+        case 7: {
+            bool ok = at != ref.end() && std::next(at) != ref.end();
+            EXPECT_EQ(list.delete_after(target), ok);
+            if (ok) ref.erase(std::next(at));
+            break;
+        }
+        default: {
+            bool ok = at != ref.end() && at != ref.begin();
+            EXPECT_EQ(list.delete_before(target), ok);
+            if (ok) ref.erase(std::prev(at));
+            break;
+        }
+    }
+    return target;
+}
+
+// Compares the list with a reference and checks the tail pointer.
+static void expectSinglyMatches(const SinglyLinkedList& list, const std::list<string>& ref) {
+    ASSERT_EQ(list.get_size(), ref.size());
+    FNode* node = list.getHead();
+    FNode* last = nullptr;
+    for (const string& v : ref) {
+        ASSERT_NE(node, nullptr);
+        ASSERT_EQ(node->key, v);
+        last = node;
+        node = node->next;
+    }
+    EXPECT_EQ(node, nullptr);
+    EXPECT_EQ(list.getTail(), last);
+}
+
+TEST(SinglyListTest, TailTrackingAndSplice) {
+    SinglyLinkedList list;
+    std::list<string> ref;
+    for (int i = 0; i < 3000; ++i) {
+        randomListEdit(list, ref, 50);
+        expectSinglyMatches(list, ref);
+        if (::testing::Test::HasFatalFailure()) return;
+    }
+
+    vector<string> batch = {"x", "y", "z"};
+    list.append_range(batch.begin(), batch.end());
+    ref.insert(ref.end(), batch.begin(), batch.end());
+    list.append_range(batch.end(), batch.end());
+    expectSinglyMatches(list, ref);
+
+    // Relinked between compatible lists, copied between heap and pool.
+    for (NodeAllocator alloc : {NodeAllocator::heap(), NodeAllocator::pool()}) {
+        SinglyLinkedList pooled(NodeAllocator::pool());
+        SinglyLinkedList other(alloc);
+        other.append_range(batch.begin(), batch.end());
+        FNode* first = other.getHead();
+        pooled.push_back("p");
+        pooled.splice(other);
+        EXPECT_TRUE(other.isEmpty());
+        EXPECT_EQ(other.getTail(), nullptr);
+        EXPECT_EQ(pooled.get_size(), 4u);
+        EXPECT_EQ(pooled.getTail()->key, "z");
+        EXPECT_EQ(pooled.getHead()->next == first, alloc.pooled);
+        other.push_back("reuse");
+        list.splice(pooled);
+        ref.push_back("p");
+        ref.insert(ref.end(), batch.begin(), batch.end());
+        expectSinglyMatches(list, ref);
+    }
+}
+
+// find_many must agree with one find per value, with and without the index.
+template <typename List>
+static void findManyCheck() {
+    mt19937 rng(49);
+    List list;
+    for (int i = 0; i < 2000; ++i) list.push_back(to_string(rng() % 700));
+    list.push_back(string(40, 'L'));
+    for (size_t k : {0, 1, 5, 8, 9, 300}) {
+        vector<string> owned;
+        for (size_t i = 0; i < k; ++i) owned.push_back(i % 7 == 6 ? "missing" : to_string(rng() % 800));
+        if (k == 300) owned[17] = owned[3] = string(40, 'L');
+        vector<string_view> queries(owned.begin(), owned.end());
+        for (int indexed = 0; indexed < 2; ++indexed) {
+            if (indexed) list.enable_index();
+            else list.disable_index();
+            auto found = list.find_many(queries);
+            ASSERT_EQ(found.size(), k);
+            for (size_t i = 0; i < k; ++i) {
+                EXPECT_EQ(found[i], list.find(owned[i])) << owned[i];
+            }
+        }
+    }
+}
+
+TEST(SinglyListTest, FindManyMatchesFind) {
+    findManyCheck<SinglyLinkedList>();
+    SinglyLinkedList empty;
+    string_view one = "a";
+    EXPECT_EQ(empty.find_many(&one, 1)[0], nullptr);
+}
+
 // 3. DOUBLY LINKED LIST TESTS
 
 TEST(DoublyListTest, BasicAndEdge) {
@@ -324,6 +934,510 @@ TEST(DoublyListTest, RandomStress) {
     list.clear();
 }
 
+// find must return the first occurrence, which the index has to track
+// through duplicates.
+TEST(DoublyListTest, IndexedEdits) {
+    for (int distinct : {8, 1000}) {
+        SinglyLinkedList singly;
+        DoublyLinkedList doubly;
+        std::list<string> singlyRef;
+        std::list<string> doublyRef;
+        for (int i = 0; i < 4000; ++i) {
+            if (i == 200) {
+                singly.enable_index();
+                doubly.enable_index();
+            }
+            randomListEdit(singly, singlyRef, distinct);
+            randomListEdit(doubly, doublyRef, distinct);
+            string probe = to_string(gen() % distinct);
+            FNode* f = singly.find(probe);
+            FNode* fExpected = singly.getHead();
+            while (fExpected && fExpected->key != probe) fExpected = fExpected->next;
+            ASSERT_EQ(f, fExpected);
+            LNode* d = doubly.find(probe);
+            LNode* dExpected = doubly.getHead();
+            while (dExpected && dExpected->data != probe) dExpected = dExpected->next;
+            ASSERT_EQ(d, dExpected);
+        }
+        EXPECT_TRUE(doubly.has_index());
+        EXPECT_GT(doubly.index_memory(), 0u);
+        expectSinglyMatches(singly, singlyRef);
+        ASSERT_EQ(doubly.get_size(), doublyRef.size());
+        LNode* node = doubly.getHead();
+        for (const string& v : doublyRef) {
+            ASSERT_EQ(node->data, v);
+            node = node->next;
+        }
+
+        // Splicing and batch appends keep the index.
+        SinglyLinkedList other;
+        vector<string> batch = {"s1", "s2", "s1"};
+        other.append_range(batch.begin(), batch.end());
+        singly.splice(other);
+        singly.append_range(batch.begin(), batch.end());
+        EXPECT_EQ(singly.find("s2"), singly.find("s1")->next);
+        singly.remove_value("s1");
+        EXPECT_EQ(singly.find("s1"), singly.find("s2")->next);
+
+        doubly.disable_index();
+        EXPECT_EQ(doubly.index_memory(), 0u);
+        singly.clear();
+        doubly.clear();
+        EXPECT_EQ(singly.find("s1"), nullptr);
+        singly.push_back("again");
+        EXPECT_EQ(singly.find("again"), singly.getHead());
+    }
+}
+
+// The predecessors behind insert_before, delete_before, remove_value and
+// pop_back have to follow every relinking edit while the index is on.
+TEST(SinglyListTest, IndexedPredecessorsAfterBulkEdits) {
+    SinglyLinkedList list;
+    std::list<string> ref;
+    list.enable_index();
+    auto edits = [&]() {
+        for (int i = 0; i < 300; ++i) randomListEdit(list, ref, 20);
+        expectSinglyMatches(list, ref);
+    };
+    edits();
+    list.sort();
+    ref.sort();
+    edits();
+    list.sort();
+    ref.sort();
+    list.unique();
+    ref.unique();
+    edits();
+
+    SinglyLinkedList sorted;
+    sorted.enable_index();
+    for (const char* v : {"0", "10", "5", "9"}) sorted.push_back(v);
+    list.sort();
+    ref.sort();
+    list.merge(sorted);
+    ref.merge(std::list<string>({"0", "10", "5", "9"}));
+    edits();
+
+    // Relinked from a heap list, then moved out of a pooled one.
+    for (NodeAllocator alloc : {NodeAllocator::heap(), NodeAllocator::pool()}) {
+        SinglyLinkedList other(alloc);
+        other.enable_index();
+        for (const char* v : {"3", "x", "3"}) other.push_back(v);
+        list.splice(other);
+        ref.insert(ref.end(), {"3", "x", "3"});
+        edits();
+    }
+
+    list.remove_if([](const string& v) { return v.size() == 1; });
+    ref.remove_if([](const string& v) { return v.size() == 1; });
+    edits();
+
+    vector<string> batch = {"7", "7", "8"};
+    list.append_range(batch.begin(), batch.end());
+    ref.insert(ref.end(), batch.begin(), batch.end());
+    edits();
+}
+
+static vector<string> doublyValues(const DoublyLinkedList& list) {
+    vector<string> values(list.begin(), list.end());
+    EXPECT_EQ(values.size(), list.get_size());
+    // Walking back from end() must give the same sequence reversed.
+    vector<string> backward;
+    auto it = list.end();
+    while (it != list.begin()) backward.push_back(*--it);
+    EXPECT_TRUE(std::equal(values.rbegin(), values.rend(), backward.begin(), backward.end()));
+    return values;
+}
+
+TEST(DoublyListTest, IteratorsAndSplice) {
+    DoublyLinkedList list;
+    std::list<string> ref;
+    for (int i = 0; i < 3000; ++i) {
+        size_t at = ref.empty() ? 0 : gen() % (ref.size() + 1);
+        auto it = list.begin();
+        auto refIt = ref.begin();
+        std::advance(it, at);
+        std::advance(refIt, at);
+        string val = to_string(gen() % 100);
+        switch (gen() % 4) {
+            case 0:
+                EXPECT_EQ(*list.insert(it, val), val);
+                ref.insert(refIt, val);
+                break;
+            case 1:
+                if (refIt == ref.end()) break;
+                list.erase(it);
+                ref.erase(refIt);
+                break;
+            case 2:
+                if (refIt == ref.end()) break;
+                list.move_to_front(it);
+                ref.splice(ref.begin(), ref, refIt);
+                break;
+            default:
+                if (refIt == ref.end()) break;
+                list.move_to_back(it);
+                ref.splice(ref.end(), ref, refIt);
+                break;
+        }
+        if (i == 1500) list.enable_index();
+    }
+    vector<string> values = doublyValues(list);
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), ref.begin(), ref.end()));
+    for (const char* v : {"1", "50", "99"}) {
+        auto expected = std::find(ref.begin(), ref.end(), v);
+        LNode* node = list.find(v);
+        EXPECT_EQ(node == nullptr, expected == ref.end());
+        if (node) {
+            EXPECT_EQ(std::distance(list.begin(), list.iterator_to(node)), std::distance(ref.begin(), expected));
+        }
+    }
+
+    // Range within one list, whole heap lists, parts of pooled lists.
+    DoublyLinkedList small;
+    for (const char* v : {"a", "b", "c", "d", "e"}) small.push_back(v);
+    auto first = std::next(small.begin());
+    small.splice(small.end(), small, first, std::next(first, 2));
+    EXPECT_EQ(doublyValues(small), vector<string>({"a", "d", "e", "b", "c"}));
+    small.splice(small.begin(), small, std::prev(small.end()));
+    EXPECT_EQ(doublyValues(small), vector<string>({"c", "a", "d", "e", "b"}));
+
+    DoublyLinkedList heap;
+    heap.push_back("x");
+    heap.push_back("y");
+    LNode* moved = heap.getHead();
+    small.enable_index();
+    small.splice(std::next(small.begin()), heap);
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(small.find("x"), moved);
+    EXPECT_EQ(doublyValues(small), vector<string>({"c", "x", "y", "a", "d", "e", "b"}));
+
+    DoublyLinkedList pooled(NodeAllocator::pool());
+    DoublyLinkedList donor(NodeAllocator::pool());
+    for (const char* v : {"1", "2", "3", "4"}) donor.push_back(v);
+    pooled.push_back("0");
+    pooled.splice(pooled.end(), donor, std::next(donor.begin()), std::prev(donor.end()));
+    EXPECT_EQ(doublyValues(pooled), vector<string>({"0", "2", "3"}));
+    EXPECT_EQ(doublyValues(donor), vector<string>({"1", "4"}));
+    LNode* kept = donor.getHead();
+    pooled.splice(pooled.begin(), donor);
+    EXPECT_EQ(pooled.getHead(), kept);
+    EXPECT_EQ(doublyValues(pooled), vector<string>({"1", "4", "0", "2", "3"}));
+    donor.push_back("reuse");
+    pooled.clear();
+    EXPECT_EQ(doublyValues(donor), vector<string>({"reuse"}));
+}
+
+// Appending another list, or its last element, passes other.end() as the
+// range end and this end() as pos: both hold a null node.
+TEST(DoublyListTest, SpliceAtEndAcrossLists) {
+    for (NodeAllocator alloc : {NodeAllocator::heap(), NodeAllocator::pool()}) {
+        DoublyLinkedList a(alloc);
+        DoublyLinkedList b(alloc);
+        a.push_back("a1");
+        b.push_back("b1");
+        b.push_back("b2");
+        a.splice(a.end(), b);
+        EXPECT_EQ(doublyValues(a), vector<string>({"a1", "b1", "b2"}));
+        EXPECT_TRUE(b.isEmpty());
+
+        DoublyLinkedList c(alloc);
+        c.push_back("c1");
+        c.push_back("c2");
+        a.splice(a.end(), c, std::prev(c.end()));
+        EXPECT_EQ(doublyValues(a), vector<string>({"a1", "b1", "b2", "c2"}));
+        EXPECT_EQ(doublyValues(c), vector<string>({"c1"}));
+        a.splice(a.end(), c, c.begin(), c.end());
+        EXPECT_EQ(doublyValues(a), vector<string>({"a1", "b1", "b2", "c2", "c1"}));
+        EXPECT_EQ(c.get_size(), 0u);
+
+        DoublyLinkedList empty(alloc);
+        empty.splice(empty.end(), a, std::prev(a.end()));
+        EXPECT_EQ(doublyValues(empty), vector<string>({"c1"}));
+        EXPECT_EQ(a.get_size(), 4u);
+    }
+}
+
+// Relinked nodes keep their iterators, and an end iterator reached from
+// one decrements to the tail of the list now holding it. Pooled lists
+// move the values of a partial splice into new nodes instead.
+TEST(DoublyListTest, IteratorsAcrossSplices) {
+    DoublyLinkedList a;
+    DoublyLinkedList b;
+    a.push_back("a1");
+    b.push_back("b1");
+    b.push_back("b2");
+    DoublyLinkedList::iterator it = std::next(b.begin());
+    DoublyLinkedList::const_iterator past = b.end();
+    a.splice(a.end(), b);
+    a.push_back("a2");
+    EXPECT_EQ(*it, "b2");
+    ++it;
+    EXPECT_EQ(*it, "a2");
+    ++it;
+    EXPECT_EQ(it, a.end());
+    --it;
+    EXPECT_EQ(it.get_node(), a.getTail());
+    b.push_back("b3");
+    --past;
+    EXPECT_EQ(*past, "b3");
+
+    DoublyLinkedList pooled(NodeAllocator::pool());
+    DoublyLinkedList donor(NodeAllocator::pool());
+    for (const char* v : {"d1", "d2"}) donor.push_back(v);
+    LNode* old = donor.getHead();
+    pooled.splice(pooled.end(), donor, donor.begin());
+    EXPECT_EQ(doublyValues(pooled), vector<string>({"d1"}));
+    EXPECT_NE(pooled.getHead(), old);
+    EXPECT_EQ(donor.getHead()->data, "d2");
+}
+
+static const string& nodeValue(const FNode* node) { return node->key; }
+static const string& nodeValue(const LNode* node) { return node->data; }
+
+template <typename List>
+static vector<string> listValues(const List& list) {
+    vector<string> values;
+    for (auto node = list.getHead(); node; node = node->next) values.push_back(nodeValue(node));
+    EXPECT_EQ(values.size(), list.get_size());
+    if (!values.empty()) {
+        EXPECT_EQ(nodeValue(list.getTail()), values.back());
+    }
+    return values;
+}
+
+// Sort must be stable and must relink the original nodes; unique, merge
+// and remove_if are checked against the std algorithms, with and without
+// the value index.
+template <typename List>
+static void sortAndMergeCheck(NodeAllocator alloc, NodeAllocator otherAlloc, bool indexed) {
+    List list(alloc);
+    for (int i = 0; i < 3000; ++i) list.push_back(to_string(gen() % 400));
+    if (indexed) list.enable_index();
+    vector<pair<string, const void*>> before;
+    for (auto node = list.getHead(); node; node = node->next) before.push_back({nodeValue(node), node});
+    std::stable_sort(before.begin(), before.end(),
+                     [](const pair<string, const void*>& a, const pair<string, const void*>& b) { return a.first < b.first; });
+    list.sort();
+    size_t i = 0;
+    for (auto node = list.getHead(); node; node = node->next, ++i) {
+        ASSERT_EQ(static_cast<const void*>(node), before[i].second);
+    }
+    vector<string> ref = listValues(list);
+    EXPECT_TRUE(std::is_sorted(ref.begin(), ref.end()));
+
+    ref.erase(std::unique(ref.begin(), ref.end()), ref.end());
+    EXPECT_EQ(list.unique(), ref.size());
+    EXPECT_EQ(listValues(list), ref);
+
+    List other(otherAlloc);
+    vector<string> extra;
+    for (int j = 0; j < 500; ++j) extra.push_back(to_string(gen() % 600));
+    std::sort(extra.begin(), extra.end());
+    for (const string& v : extra) other.push_back(v);
+    list.merge(other);
+    EXPECT_TRUE(other.isEmpty());
+    vector<string> merged;
+    std::merge(ref.begin(), ref.end(), extra.begin(), extra.end(), back_inserter(merged));
+    EXPECT_EQ(listValues(list), merged);
+
+    auto odd = [](const string& v) { return (v.back() - '0') % 2 == 1; };
+    size_t total = merged.size();
+    size_t removed = list.remove_if(odd);
+    merged.erase(std::remove_if(merged.begin(), merged.end(), odd), merged.end());
+    EXPECT_EQ(removed, total - merged.size());
+    EXPECT_EQ(listValues(list), merged);
+    for (const string& v : {string("10"), string("42"), string("599")}) {
+        auto node = list.find(v);
+        auto expected = list.getHead();
+        while (expected && nodeValue(expected) != v) expected = expected->next;
+        EXPECT_EQ(node, expected);
+    }
+
+    List empty(alloc);
+    empty.sort();
+    EXPECT_EQ(empty.unique(), 0u);
+    empty.merge(list);
+    EXPECT_EQ(listValues(empty), merged);
+    EXPECT_TRUE(list.isEmpty());
+}
+
+// Splicing part of an indexed list must not leave the source's index
+// pointing at nodes that moved out.
+TEST(DoublyListTest, IndexedSpliceAcrossLists) {
+    DoublyLinkedList list;
+    DoublyLinkedList other;
+    list.enable_index();
+    other.enable_index();
+    for (const char* v : {"a", "a", "a", "b"}) other.push_back(v);
+    auto last = other.begin();
+    ++last;
+    ++last;
+    list.splice(list.end(), other, other.begin(), last);
+    EXPECT_EQ(list.get_size(), 2u);
+    EXPECT_EQ(other.get_size(), 2u);
+    EXPECT_EQ(other.find("a"), other.getHead());
+    other.remove_value("a");
+    EXPECT_EQ(other.find("a"), nullptr);
+    EXPECT_EQ(other.getHead()->data, "b");
+    EXPECT_EQ(list.find("a"), list.getHead());
+    list.remove_value("a");
+    list.remove_value("a");
+    EXPECT_TRUE(list.isEmpty());
+
+    // Every occurrence in the moved range.
+    for (const char* v : {"x", "x", "y"}) other.push_back(v);
+    auto y = other.end();
+    --y;
+    list.splice(list.end(), other, other.iterator_to(other.find("x")), y);
+    EXPECT_EQ(other.find("x"), nullptr);
+    EXPECT_EQ(list.find("x"), list.getHead());
+    EXPECT_EQ(other.get_size(), 2u);
+}
+
+TEST(DoublyListTest, FindManyMatchesFind) {
+    findManyCheck<DoublyLinkedList>();
+}
+
+TEST(DoublyListTest, SortUniqueMergeRemoveIf) {
+    sortAndMergeCheck<SinglyLinkedList>(NodeAllocator::heap(), NodeAllocator::heap(), false);
+    sortAndMergeCheck<SinglyLinkedList>(NodeAllocator::pool(), NodeAllocator::heap(), true);
+    sortAndMergeCheck<DoublyLinkedList>(NodeAllocator::heap(), NodeAllocator::pool(), false);
+    sortAndMergeCheck<DoublyLinkedList>(NodeAllocator::pool(), NodeAllocator::pool(), true);
+
+    DoublyLinkedList list;
+    for (const char* v : {"c", "a", "b", "a"}) list.push_back(v);
+    list.sort();
+    EXPECT_EQ(doublyValues(list), vector<string>({"a", "a", "b", "c"}));
+}
+
+TEST(DoublyListTest, CompactStorage) {
+    CompactDoublyList list;
+    std::list<string> ref;
+    for (int i = 0; i < 4000; ++i) {
+        randomListEdit(list, ref, 40);
+        ASSERT_EQ(list.get_size(), ref.size());
+        ASSERT_LE(list.get_size(), list.get_slot_count());
+    }
+    vector<string> values(list.begin(), list.end());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), ref.begin(), ref.end()));
+    vector<string> backward;
+    for (auto it = list.end(); it != list.begin();) backward.push_back(*--it);
+    EXPECT_TRUE(std::equal(backward.begin(), backward.end(), ref.rbegin(), ref.rend()));
+
+    // Freed slots are reused before the array grows.
+    size_t slotsBefore = list.get_slot_count();
+    list.push_back("tail");
+    list.pop_back();
+    list.push_front("head");
+    EXPECT_EQ(list.get_slot_count(), max(slotsBefore, list.get_size()));
+    EXPECT_EQ(list.get(list.find("head")), "head");
+    EXPECT_EQ(list.find("missing"), -1);
+    list.erase(list.begin());
+
+    list.compact();
+    EXPECT_EQ(list.get_slot_count(), list.get_size());
+    int slot = 0;
+    for (auto it = list.begin(); it != list.end(); ++it, ++slot) EXPECT_EQ(it.get_slot(), (uint32_t)slot);
+    values.assign(list.begin(), list.end());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), ref.begin(), ref.end()));
+
+    // Same file formats as DoublyLinkedList.
+    saveToBinary(list, "test_compact.bin");
+    DoublyLinkedList doubly;
+    loadFromBinary(doubly, "test_compact.bin");
+    EXPECT_TRUE(std::equal(doubly.begin(), doubly.end(), ref.begin(), ref.end()));
+    saveToText(doubly, "test_compact.txt");
+    CompactDoublyList loaded;
+    loadFromText(loaded, "test_compact.txt");
+    EXPECT_TRUE(std::equal(loaded.begin(), loaded.end(), ref.begin(), ref.end()));
+
+    list.clear();
+    list.compact();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.begin(), list.end());
+    list.insert(list.end(), "only");
+    EXPECT_EQ(*list.begin(), "only");
+}
+
+// Random edits on an unrolled list mirrored on std::list; blocks must stay
+// non-empty and linked both ways.
+template <int Capacity>
+static void unrolledStress(NodeAllocator alloc) {
+    UnrolledLinkedList<Capacity> list(alloc);
+    std::list<string> ref;
+    for (int i = 0; i < 4000; ++i) {
+        string target = randomListEdit(list, ref, 60);
+        EXPECT_EQ(list.contains(target), std::find(ref.begin(), ref.end(), target) != ref.end());
+        ASSERT_EQ(list.get_size(), ref.size());
+    }
+
+    auto expected = ref.begin();
+    size_t blocks = 0;
+    typename UnrolledLinkedList<Capacity>::Node* prev = nullptr;
+    for (auto* block = list.getHead(); block; block = block->next) {
+        ASSERT_GT(block->count, 0);
+        ASSERT_EQ(block->prev, prev);
+        if (block->prev && block->next) {
+            EXPECT_GE(block->count, Capacity / 2);
+        }
+        for (int i = 0; i < block->count; ++i) EXPECT_EQ(block->items[i], *expected++);
+        prev = block;
+        blocks++;
+    }
+    EXPECT_EQ(list.getTail(), prev);
+    EXPECT_EQ(blocks, list.get_block_count());
+    EXPECT_EQ(list.get(ref.size()), "");
+    if (!ref.empty()) {
+        EXPECT_EQ(list.get(ref.size() - 1), ref.back());
+    }
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.get_block_count(), 0u);
+}
+
+TEST(UnrolledListTest, RandomStress) {
+    unrolledStress<2>(NodeAllocator::heap());
+    unrolledStress<4>(NodeAllocator::heap());
+    unrolledStress<7>(NodeAllocator::pool());
+}
+
+// Emptying every other block down to one element used to leave a run of
+// nearly empty blocks between full ones: only the successor was checked
+// for a merge.
+TEST(UnrolledListTest, DeletesKeepBlocksHalfFull) {
+    UnrolledLinkedList<8> list;
+    for (int i = 0; i < 800; ++i) list.push_back(to_string(i));
+    EXPECT_EQ(list.get_block_count(), 100u);
+    for (int block = 1; block < 100; block += 2) {
+        for (int i = 1; i < 8; ++i) list.remove_value(to_string(block * 8 + i));
+    }
+    EXPECT_EQ(list.get_size(), 450u);
+    EXPECT_LE(list.get_block_count(), 450u / 4 + 1);
+    for (auto* block = list.getHead(); block; block = block->next) {
+        if (block->prev && block->next) {
+            EXPECT_GE(block->count, 4);
+        }
+    }
+    EXPECT_EQ(list.get(8), "8");
+    EXPECT_EQ(list.get(9), "16");
+    EXPECT_EQ(list.get(449), "792");
+}
+
+TEST(UnrolledListTest, BlocksStayFull) {
+    UnrolledLinkedList<4> list;
+    for (int i = 0; i < 1000; ++i) list.push_back(to_string(i));
+    EXPECT_EQ(list.get_block_count(), 250u);
+    // Inserting an element of the list into itself.
+    EXPECT_TRUE(list.insert_after("500", *list.find("7")));
+    EXPECT_EQ(list.get(501), "7");
+    EXPECT_EQ(list.get_block_count(), 251u);
+    for (int i = 0; i < 1000; i += 2) list.remove_value(to_string(i));
+    EXPECT_EQ(list.get_size(), 501u);
+    EXPECT_LE(list.get_block_count(), 251u);
+    EXPECT_EQ(list.get(0), "1");
+}
+
 // 4. STACK TESTS
 
 TEST(StackTest, BasicOperations) {
@@ -402,6 +1516,156 @@ TEST(QueueTest, RandomStress) {
     }
 }
 
+TEST(QueueTest, RingBufferWrapAndBulk) {
+    Queue q;
+    string out = "untouched";
+    EXPECT_FALSE(q.try_pop(out));
+    EXPECT_EQ(out, "untouched");
+    q.push("");
+    EXPECT_TRUE(q.try_pop(out));
+    EXPECT_EQ(out, "");
+
+    // Keep the head moving so growth happens while the contents wrap.
+    queue<string> ref;
+    int next = 0;
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            q.emplace(to_string(next));
+            ref.push(to_string(next++));
+        }
+        for (int i = 0; i < 2; ++i) {
+            ASSERT_TRUE(q.try_pop(out));
+            EXPECT_EQ(out, ref.front());
+            ref.pop();
+        }
+    }
+    EXPECT_EQ(q.get_size(), ref.size());
+    size_t cap = q.get_capacity();
+    EXPECT_EQ(cap & (cap - 1), 0u);
+    EXPECT_GE(cap, q.get_size());
+
+    // Values move in and out without copying their heap buffers.
+    string big(100, 'b');
+    const char* bytes = big.data();
+    q.push(std::move(big));
+    ref.push(string(100, 'b'));
+    q.emplace(5, 'e');
+    ref.push("eeeee");
+    // Growth while pushing an element of the queue itself.
+    while (q.get_size() < q.get_capacity()) {
+        q.push("fill");
+        ref.push("fill");
+    }
+    q.emplace(q.peek());
+    ref.push(ref.front());
+
+    vector<string> batch = {"x", "y", "z"};
+    q.push_range(batch.begin(), batch.end());
+    for (const string& v : batch) ref.push(v);
+    std::list<string> linked = {"l1", "l2"};
+    q.push_range(linked.begin(), linked.end());
+    ref.push("l1");
+    ref.push("l2");
+
+    vector<string> drained;
+    EXPECT_EQ(q.pop_n(q.get_size() + 10, back_inserter(drained)), ref.size());
+    EXPECT_TRUE(q.isEmpty());
+    bool sawBig = false;
+    for (const string& v : drained) {
+        EXPECT_EQ(v, ref.front());
+        ref.pop();
+        if (v.data() == bytes) sawBig = true;
+    }
+    EXPECT_TRUE(sawBig);
+    EXPECT_EQ(q.pop_n(4, back_inserter(drained)), 0u);
+    EXPECT_EQ(q.pop(), "");
+}
+
+// Counts the bytes a pooled container still holds from the resource.
+struct CountingResource : std::pmr::memory_resource {
+    long long outstanding = 0;
+    void* do_allocate(size_t bytes, size_t align) override {
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST(QueueTest, PooledNodeAllocators) {
+    CountingResource resource;
+    for (NodeAllocator alloc : {NodeAllocator::heap(), NodeAllocator::pool(), NodeAllocator::pool(&resource)}) {
+        Queue myQueue(alloc);
+        Stack myStack(alloc);
+        queue<string> stdQueue;
+        stack<string> stdStack;
+        for (int i = 0; i < 20000; ++i) {
+            if (gen() % 3 != 0) {
+                // Long enough to live on the heap, so moved-out values are checked.
+                string val = randomString(gen() % 40);
+                myQueue.push(val);
+                myStack.push(val);
+                stdQueue.push(val);
+                stdStack.push(val);
+            } else if (!stdQueue.empty()) {
+                ASSERT_EQ(myQueue.pop(), stdQueue.front());
+                ASSERT_EQ(myStack.pop(), stdStack.top());
+                stdQueue.pop();
+                stdStack.pop();
+            }
+        }
+        EXPECT_EQ(myQueue.get_size(), stdQueue.size());
+        EXPECT_EQ(myStack.peek(), stdStack.top());
+        if (alloc.resource) {
+            EXPECT_GT(resource.outstanding, 0);
+        }
+        myQueue.clear();
+        myStack.clear();
+        EXPECT_TRUE(myQueue.isEmpty());
+        EXPECT_EQ(resource.outstanding, 0);
+        myQueue.push("again");
+        myStack.push("again");
+        EXPECT_EQ(myQueue.pop(), "again");
+        EXPECT_EQ(myStack.peek(), "again");
+    }
+    EXPECT_EQ(resource.outstanding, 0);
+
+    // Lists on a pool keep working through removals from the middle.
+    SinglyLinkedList singly(NodeAllocator::pool(&resource));
+    DoublyLinkedList doubly(NodeAllocator::pool());
+    list<string> ref;
+    for (int i = 0; i < 2000; ++i) {
+        string val = to_string(gen() % 500);
+        if (gen() % 2) {
+            singly.push_front(val);
+            doubly.push_front(val);
+            ref.push_front(val);
+        } else {
+            singly.remove_value(val);
+            doubly.remove_value(val);
+            auto it = std::find(ref.begin(), ref.end(), val);
+            if (it != ref.end()) ref.erase(it);
+        }
+    }
+    ASSERT_EQ(singly.get_size(), ref.size());
+    ASSERT_EQ(doubly.get_size(), ref.size());
+    FNode* f = singly.getHead();
+    LNode* d = doubly.getHead();
+    for (const string& v : ref) {
+        EXPECT_EQ(f->key, v);
+        EXPECT_EQ(d->data, v);
+        f = f->next;
+        d = d->next;
+    }
+    singly.clear();
+    doubly.clear();
+    EXPECT_EQ(doubly.getTail(), nullptr);
+    EXPECT_EQ(resource.outstanding, 0);
+}
+
 // 6. HASH TABLE (CHAINING) TESTS
 
 TEST(HashTableTest, BasicOperations) {
@@ -496,6 +1760,28 @@ TEST(HashTableOpenTest, StressWithLoad) {
     }
 }
 
+TEST(HashTableOpenTest, MemoryPolicies) {
+    for (NumaPolicy numa : {NumaPolicy::Local, NumaPolicy::Interleave, NumaPolicy::FirstTouch}) {
+        // 100K entries is well past one huge page, so the mapped path runs.
+        HashTableOpen ht(100000, MemoryPolicy(true, numa));
+        for (int i = 0; i < 50000; ++i) ht.insert("k" + to_string(i), to_string(i));
+        EXPECT_EQ(ht.get("k123"), "123");
+        EXPECT_EQ(ht.get("k49999"), "49999");
+        EXPECT_EQ(ht.get("missing"), "");
+    }
+
+    using PolicyArray = DynamicArray<int, 0, PolicyArrayAllocator>;
+    PolicyArray big(4, PolicyArrayAllocator(MemoryPolicy(true, NumaPolicy::Interleave)));
+    for (int i = 0; i < 2000000; ++i) big.push_back(i);
+    EXPECT_EQ(big.get(1999999), 1999999);
+    PolicyArray moved(std::move(big));
+    PolicyArray copy(moved);
+    EXPECT_EQ(copy.count(7), 1);
+    big = std::move(copy);
+    EXPECT_EQ(big.get_size(), 2000000);
+    EXPECT_EQ(sizeof(DynamicArray<int>), sizeof(int*) + 2 * sizeof(int));
+}
+
 // 8. BINARY SEARCH TREE TESTS
 
 TEST(BSTTest, BasicOperations) {
@@ -588,6 +1874,225 @@ TEST(BSTTest, RandomStress) {
     EXPECT_TRUE(bst.isEmpty());
 }
 
+TEST(BSTTest, IteratorInOrder) {
+    BinarySearchTree bst;
+    EXPECT_TRUE(bst.begin() == bst.end());
+
+    set<int> stdSet;
+    uniform_int_distribution<> valDist(1, 1000);
+    for (int i = 0; i < 500; ++i) {
+        int val = valDist(gen);
+        bst.insert(val);
+        stdSet.insert(val);
+    }
+    vector<int> keys(bst.begin(), bst.end());
+    EXPECT_EQ(keys, vector<int>(stdSet.begin(), stdSet.end()));
+}
+
+TEST(BSTTest, GenericKeysAndValues) {
+    BinarySearchTree<string, int, less<>> bst;
+    bst.insert("banana", 2);
+    bst.insert("apple", 1);
+    bst.insert("cherry", 3);
+    bst.insert("apple", 10);
+
+    EXPECT_TRUE(bst.contains(string("apple")));
+    EXPECT_TRUE(bst.contains(string_view("cherry")));
+    EXPECT_FALSE(bst.contains("durian"));
+    ASSERT_NE(bst.find(string_view("apple")), nullptr);
+    EXPECT_EQ(*bst.find(string_view("apple")), 10);
+    EXPECT_EQ(bst.find("durian"), nullptr);
+
+    *bst.find("banana") = 20;
+    EXPECT_EQ(*bst.find("banana"), 20);
+
+    vector<string> keys;
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        keys.push_back(*it + "=" + to_string(it.value()));
+    }
+    EXPECT_EQ(keys, (vector<string>{"apple=10", "banana=20", "cherry=3"}));
+
+    bst.remove("banana");
+    EXPECT_FALSE(bst.contains("banana"));
+
+    BinarySearchTree<long long, void, greater<long long>> desc;
+    desc.insert(1);
+    desc.insert(3);
+    desc.insert(2);
+    EXPECT_EQ(vector<long long>(desc.begin(), desc.end()), (vector<long long>{3, 2, 1}));
+}
+
+TEST(BSTTest, RandomStressStringKeys) {
+    BinarySearchTree<string> bst;
+    set<string> stdSet;
+    uniform_int_distribution<> opDist(0, 2);
+
+    for (int i = 0; i < 1000; ++i) {
+        int op = opDist(gen);
+        string val = randomString(2);
+
+        if (op == 0) {
+            bst.insert(val);
+            stdSet.insert(val);
+        } else if (op == 1) {
+            bst.remove(val);
+            stdSet.erase(val);
+        } else {
+            EXPECT_EQ(bst.contains(val), (stdSet.find(val) != stdSet.end()));
+        }
+    }
+    EXPECT_EQ(vector<string>(bst.begin(), bst.end()), vector<string>(stdSet.begin(), stdSet.end()));
+}
+
+TEST(BSTTest, SplitAndJoin) {
+    BinarySearchTree bst;
+    for (int key : {50, 30, 70, 20, 40, 60, 80}) bst.insert(key);
+
+    BinarySearchTree less, greater;
+    EXPECT_TRUE(bst.split(50, less, greater));
+    EXPECT_TRUE(bst.isEmpty());
+    EXPECT_EQ(vector<int>(less.begin(), less.end()), (vector<int>{20, 30, 40}));
+    EXPECT_EQ(vector<int>(greater.begin(), greater.end()), (vector<int>{60, 70, 80}));
+
+    EXPECT_FALSE(greater.split(65, bst, less));
+    EXPECT_EQ(vector<int>(bst.begin(), bst.end()), (vector<int>{60}));
+    EXPECT_EQ(vector<int>(less.begin(), less.end()), (vector<int>{70, 80}));
+
+    bst.join(less);
+    EXPECT_TRUE(less.isEmpty());
+    EXPECT_EQ(vector<int>(bst.begin(), bst.end()), (vector<int>{60, 70, 80}));
+
+    // The tree being split may receive one of the halves.
+    EXPECT_TRUE(bst.split(70, bst, greater));
+    EXPECT_EQ(vector<int>(bst.begin(), bst.end()), (vector<int>{60}));
+    EXPECT_EQ(vector<int>(greater.begin(), greater.end()), (vector<int>{80}));
+    bst.join(greater);
+    EXPECT_FALSE(bst.split(75, less, bst));
+    EXPECT_EQ(vector<int>(less.begin(), less.end()), (vector<int>{60}));
+    EXPECT_EQ(vector<int>(bst.begin(), bst.end()), (vector<int>{80}));
+    less.join(less);
+    EXPECT_TRUE(less.split(60, less, less));
+    EXPECT_TRUE(less.isEmpty());
+    less.insert(1);
+    less.insert(9);
+    EXPECT_FALSE(less.split(5, greater, greater));
+    EXPECT_EQ(vector<int>(greater.begin(), greater.end()), (vector<int>{1, 9}));
+}
+
+TEST(BSTTest, SetOperationsMatchStd) {
+    uniform_int_distribution<> valDist(1, 3000);
+    for (unsigned threads : {1u, 4u}) {
+        for (int sizeB : {0, 10, 1000}) {
+            set<int> sa, sb;
+            for (int i = 0; i < 1000; ++i) sa.insert(valDist(gen));
+            for (int i = 0; i < sizeB; ++i) sb.insert(valDist(gen));
+
+            auto build = [](BinarySearchTree<>& t, const set<int>& keys) {
+                vector<int> shuffled(keys.begin(), keys.end());
+                shuffle(shuffled.begin(), shuffled.end(), gen);
+                for (int key : shuffled) t.insert(key);
+            };
+
+            vector<int> expected;
+            BinarySearchTree a1, b1;
+            build(a1, sa);
+            build(b1, sb);
+            a1.union_with(std::move(b1), threads);
+            set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            EXPECT_EQ(vector<int>(a1.begin(), a1.end()), expected);
+            EXPECT_TRUE(b1.isEmpty());
+
+            expected.clear();
+            BinarySearchTree a2, b2;
+            build(a2, sa);
+            build(b2, sb);
+            a2.intersect_with(std::move(b2), threads);
+            set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            EXPECT_EQ(vector<int>(a2.begin(), a2.end()), expected);
+
+            expected.clear();
+            BinarySearchTree a3, b3;
+            build(a3, sa);
+            build(b3, sb);
+            a3.difference(std::move(b3), threads);
+            set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), back_inserter(expected));
+            EXPECT_EQ(vector<int>(a3.begin(), a3.end()), expected);
+        }
+
+        // other may be the tree itself.
+        BinarySearchTree self;
+        for (int key : {5, 2, 8, 1, 9}) self.insert(key);
+        self.union_with(std::move(self), threads);
+        EXPECT_EQ(vector<int>(self.begin(), self.end()), vector<int>({1, 2, 5, 8, 9}));
+        self.intersect_with(std::move(self), threads);
+        EXPECT_EQ(vector<int>(self.begin(), self.end()), vector<int>({1, 2, 5, 8, 9}));
+        self.difference(std::move(self), threads);
+        EXPECT_TRUE(self.isEmpty());
+    }
+}
+
+TEST(BSTTest, SetOperationsOnDegenerateTrees) {
+    const int n = 200000;
+    auto chain = [](BinarySearchTree<>& t, int from, int step, int count) {
+        TreeNode<>* root = new TreeNode<>(from);
+        TreeNode<>* tail = root;
+        for (int i = 1; i < count; ++i) {
+            tail->right = new TreeNode<>(from + i * step);
+            tail = tail->right;
+        }
+        t.setRoot(root);
+    };
+    BinarySearchTree evens, thirds;
+    chain(evens, 0, 2, n);
+    chain(thirds, 0, 3, n);
+    evens.intersect_with(std::move(thirds), 2);
+
+    int count = 0;
+    for (int key : evens) {
+        EXPECT_EQ(key % 6, 0);
+        ++count;
+    }
+    EXPECT_EQ(count, (2 * (n - 1)) / 6 + 1);
+}
+
+TEST(BSTTest, DegenerateTreeNoStackOverflow) {
+    const int n = 300000;
+    TreeNode<>* root = new TreeNode<>(0);
+    TreeNode<>* tail = root;
+    for (int i = 1; i < n; ++i) {
+        tail->right = new TreeNode<>(i);
+        tail = tail->right;
+    }
+    BinarySearchTree bst;
+    bst.setRoot(root);
+    EXPECT_TRUE(bst.contains(n - 1));
+
+    saveToBinary(bst, "test_bst_deep.bin");
+    saveToText(bst, "test_bst_deep.txt");
+
+    BinarySearchTree fromBinary;
+    loadFromBinary(fromBinary, "test_bst_deep.bin");
+    EXPECT_TRUE(fromBinary.contains(0));
+    EXPECT_TRUE(fromBinary.contains(n - 1));
+
+    BinarySearchTree fromText;
+    loadFromText(fromText, "test_bst_deep.txt");
+    EXPECT_TRUE(fromText.contains(n / 2));
+
+    int count = 0;
+    for (int key : fromText) {
+        EXPECT_EQ(key, count);
+        ++count;
+    }
+    EXPECT_EQ(count, n);
+
+    bst.remove(0);
+    bst.remove(n - 1);
+    EXPECT_FALSE(bst.contains(0));
+    bst.clear();
+    EXPECT_TRUE(bst.isEmpty());
+}
+
 
 // 9. SERIALIZATION TESTS
 
@@ -624,6 +2129,128 @@ TEST(SerializationTest, DynamicArrayBinaryFormat) {
     EXPECT_EQ(arr2.get(1), "data");
 }
 
+TEST(SerializationTest, StringPoolArrayFormats) {
+    StringPoolArray arr;
+    arr.push_back("pool");
+    arr.push_back("");
+    arr.push_back("column");
+
+    saveToBinary(arr, "test_pool.bin");
+    DynamicArray<string> asArray;
+    loadFromBinary(asArray, "test_pool.bin");
+    EXPECT_EQ(asArray.get_size(), 3);
+    EXPECT_EQ(asArray.get(2), "column");
+
+    StringPoolArray fromBinary;
+    loadFromBinary(fromBinary, "test_pool.bin");
+    EXPECT_EQ(fromBinary.get_size(), 3);
+    EXPECT_EQ(fromBinary.get(0), "pool");
+    EXPECT_EQ(fromBinary.get(1), "");
+
+    saveToText(arr, "test_pool.txt");
+    StringPoolArray fromText;
+    loadFromText(fromText, "test_pool.txt");
+    EXPECT_EQ(fromText.get(2), "column");
+}
+
+TEST(SerializationTest, MappedArrayReopen) {
+    std::remove("test_mapped.bin");
+    {
+        MappedArray<long long> arr("test_mapped.bin", 4);
+        EXPECT_EQ(arr.get_size(), 0u);
+        EXPECT_EQ(arr.get(0), 0);
+        for (long long i = 0; i < 10000; ++i) arr.push_back(i * i);
+        arr.push_back(arr[3]);
+        arr.set(1, -1);
+        arr.append(&arr[0], 3);
+        arr.advise(MappedArray<long long>::Access::Sequential);
+        arr.flush();
+    }
+    {
+        MappedArray<long long> arr("test_mapped.bin");
+        ASSERT_EQ(arr.get_size(), 10004u);
+        EXPECT_EQ(arr.get(1), -1);
+        EXPECT_EQ(arr.get(9999), 9999LL * 9999);
+        EXPECT_EQ(arr.get(10000), 9);
+        EXPECT_EQ(arr.get(10003), 4);
+        EXPECT_GE(arr.get_capacity(), arr.get_size());
+        arr.pop_back();
+        EXPECT_EQ(arr.get_size(), 10003u);
+    }
+    EXPECT_THROW(MappedArray<int> wrongType("test_mapped.bin"), std::runtime_error);
+    EXPECT_THROW(MappedArray<int> missingDir("no_such_dir/test_mapped.bin"), std::runtime_error);
+
+    std::remove("test_mapped_str.idx");
+    std::remove("test_mapped_str.blob");
+    {
+        MappedStringArray arr("test_mapped_str", 2);
+        for (int i = 0; i < 1000; ++i) arr.push_back("value" + to_string(i));
+        arr.set(0, "value9");
+        arr.set(1, arr.get(999));
+        arr.push_back("");
+        arr.flush();
+    }
+    MappedStringArray arr("test_mapped_str");
+    arr.advise(MappedStringArray::Access::Random);
+    ASSERT_EQ(arr.get_size(), 1001u);
+    EXPECT_EQ(arr.get(0), "value9");
+    EXPECT_EQ(arr.get(1), "value999");
+    EXPECT_EQ(arr.get(500), "value500");
+    EXPECT_EQ(arr.get(1000), "");
+    EXPECT_EQ(arr.get(1001), "");
+}
+
+TEST(SerializationTest, ExternalSortSpillsAndMerges) {
+    DynamicArray<string> input;
+    vector<string> ref;
+    for (int i = 0; i < 20000; ++i) {
+        string v = randomString(gen() % 12);
+        input.push_back(v);
+        ref.push_back(v);
+    }
+    saveToBinary(input, "test_extsort_in.bin");
+    std::sort(ref.begin(), ref.end());
+
+    ExternalSortOptions options;
+    options.memoryBudget = 32 * 1024;
+    options.ioBufferSize = 4096;
+    options.threads = 2;
+    externalSortFile("test_extsort_in.bin", "test_extsort_out.bin", options);
+    DynamicArray<string> output;
+    loadFromBinary(output, "test_extsort_out.bin");
+    ASSERT_EQ(output.get_size(), (int)ref.size());
+    for (size_t i = 0; i < ref.size(); ++i) ASSERT_EQ(output[i], ref[i]);
+
+    // Chunks added directly: all in memory, one merge pass, several passes.
+    for (int pass = 0; pass < 3; ++pass) {
+        options.memoryBudget = pass == 0 ? size_t(1) << 30 : 16 * 1024;
+        options.maxMergeWidth = pass == 2 ? 3 : 128;
+        ExternalSorter sorter(options);
+        for (int i = 0; i < 4; ++i) sorter.add(input);
+        EXPECT_EQ(sorter.get_size(), 80000);
+        if (pass > 0) {
+            EXPECT_GT(sorter.get_run_count(), 3);
+        }
+        string previous;
+        int seen = 0;
+        sorter.merge([&](string& value) {
+            if (seen > 0) {
+                ASSERT_LE(previous, value);
+            }
+            previous = std::move(value);
+            seen++;
+        });
+        EXPECT_EQ(seen, 80000);
+        EXPECT_EQ(sorter.get_run_count(), 0);
+    }
+
+    ExternalSorter empty(options);
+    empty.finish("test_extsort_empty.bin");
+    loadFromBinary(output, "test_extsort_empty.bin");
+    EXPECT_EQ(output.get_size(), 0);
+    EXPECT_THROW(externalSortFile("no_such_input.bin", "out.bin"), std::runtime_error);
+}
+
 TEST(SerializationTest, SinglyListTextFormat) {
     SinglyLinkedList list;
     list.push_back("one");
@@ -840,6 +2467,39 @@ TEST(SerializationTest, BSTBinaryFormat) {
     EXPECT_FALSE(bst2.contains(999));
 }
 
+TEST(SerializationTest, BSTGenericFormats) {
+    BinarySearchTree<string, string> bst;
+    bst.insert("m", "middle");
+    bst.insert("#", "hash");
+    bst.insert("z", "");
+    bst.insert("a", "first value");
+
+    saveToText(bst, "test_bst_map.txt");
+    saveToBinary(bst, "test_bst_map.bin");
+
+    BinarySearchTree<string, string> fromText;
+    loadFromText(fromText, "test_bst_map.txt");
+    BinarySearchTree<string, string> fromBinary;
+    loadFromBinary(fromBinary, "test_bst_map.bin");
+
+    for (auto* loaded : {&fromText, &fromBinary}) {
+        ASSERT_NE(loaded->find("#"), nullptr);
+        EXPECT_EQ(*loaded->find("#"), "hash");
+        EXPECT_EQ(*loaded->find("a"), "first value");
+        EXPECT_EQ(*loaded->find("z"), "");
+        EXPECT_EQ(vector<string>(loaded->begin(), loaded->end()), (vector<string>{"#", "a", "m", "z"}));
+    }
+
+    BinarySearchTree<int, double> weights;
+    weights.insert(5, 0.5);
+    weights.insert(-3, 2.25);
+    saveToBinary(weights, "test_bst_weights.bin");
+    BinarySearchTree<int, double> weights2;
+    loadFromBinary(weights2, "test_bst_weights.bin");
+    EXPECT_EQ(*weights2.find(5), 0.5);
+    EXPECT_EQ(*weights2.find(-3), 2.25);
+}
+
 // 10. PRINT FUNCTIONS COVERAGE TESTS
 
 TEST(PrintTest, DynamicArrayPrint) {
@@ -924,6 +2584,269 @@ TEST(PrintTest, HashTableOpenPrint) {
     EXPECT_FALSE(output.empty());
 }
 
+// 11. FROZEN SEARCH LAYOUT TESTS
+
+TEST(EytzingerTest, EmptyAndSingle) {
+    BinarySearchTree bst;
+    EytzingerTree eyt(bst);
+    BlockedEytzingerTree blocked(bst);
+    EXPECT_TRUE(eyt.isEmpty());
+    EXPECT_FALSE(eyt.contains(0));
+    EXPECT_EQ(eyt.lower_bound(0), nullptr);
+    EXPECT_FALSE(blocked.contains(0));
+    EXPECT_EQ(blocked.lower_bound(0), nullptr);
+
+    bst.insert(INT_MAX);
+    eyt.build(collectSortedKeys(bst));
+    blocked.build(collectSortedKeys(bst));
+    EXPECT_TRUE(eyt.contains(INT_MAX));
+    EXPECT_TRUE(blocked.contains(INT_MAX));
+    EXPECT_EQ(*blocked.lower_bound(5), INT_MAX);
+}
+
+TEST(EytzingerTest, MatchesBSTAndLowerBound) {
+    BinarySearchTree bst;
+    set<int> stdSet;
+    uniform_int_distribution<> valDist(-5000, 5000);
+    for (int i = 0; i < 3000; ++i) {
+        int val = valDist(gen);
+        bst.insert(val);
+        stdSet.insert(val);
+    }
+
+    EytzingerTree eyt(bst);
+    BlockedEytzingerTree blocked(bst);
+    EXPECT_EQ(eyt.get_size(), (int)stdSet.size());
+    EXPECT_EQ(blocked.get_size(), (int)stdSet.size());
+
+    for (int q = -5100; q <= 5100; ++q) {
+        EXPECT_EQ(eyt.contains(q), bst.contains(q));
+        EXPECT_EQ(blocked.contains(q), bst.contains(q));
+
+        auto it = stdSet.lower_bound(q);
+        const int* a = eyt.lower_bound(q);
+        const int* b = blocked.lower_bound(q);
+        if (it == stdSet.end()) {
+            EXPECT_EQ(a, nullptr);
+            EXPECT_EQ(b, nullptr);
+        } else {
+            ASSERT_NE(a, nullptr);
+            ASSERT_NE(b, nullptr);
+            EXPECT_EQ(*a, *it);
+            EXPECT_EQ(*b, *it);
+        }
+    }
+}
+
+// 12. PERSISTENT TREE TESTS
+
+TEST(PersistentTreeTest, SnapshotsAreIsolated) {
+    PersistentTree<> tree;
+    EXPECT_TRUE(tree.isEmpty());
+    tree.insert(50);
+    tree.insert(30);
+    tree.insert(70);
+
+    auto before = tree.snapshot();
+    tree.insert(40);
+    auto middle = tree.snapshot();
+    tree.remove(50);
+    tree.remove(99);
+
+    EXPECT_TRUE(before.contains(50));
+    EXPECT_FALSE(before.contains(40));
+    EXPECT_EQ(vector<int>(before.begin(), before.end()), (vector<int>{30, 50, 70}));
+
+    auto after = tree.snapshot();
+    EXPECT_FALSE(after.contains(50));
+    EXPECT_EQ(vector<int>(after.begin(), after.end()), (vector<int>{30, 40, 70}));
+
+    // Untouched subtrees are shared, not copied.
+    EXPECT_NE(before.getRoot(), middle.getRoot());
+    EXPECT_EQ(before.getRoot()->right.get(), middle.getRoot()->right.get());
+
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_FALSE(after.isEmpty());
+}
+
+TEST(PersistentTreeTest, MappedValues) {
+    PersistentTree<string, int> tree;
+    tree.insert("a", 1);
+    auto v1 = tree.snapshot();
+    tree.insert("a", 2);
+    EXPECT_EQ(*v1.find("a"), 1);
+    EXPECT_EQ(*tree.snapshot().find("a"), 2);
+    EXPECT_EQ(tree.snapshot().find("b"), nullptr);
+}
+
+TEST(PersistentTreeTest, RandomStressAgainstSet) {
+    PersistentTree<> tree;
+    set<int> stdSet;
+    uniform_int_distribution<> opDist(0, 2);
+    uniform_int_distribution<> valDist(1, 500);
+
+    for (int i = 0; i < 2000; ++i) {
+        int op = opDist(gen);
+        int val = valDist(gen);
+        if (op == 0) {
+            tree.insert(val);
+            stdSet.insert(val);
+        } else if (op == 1) {
+            tree.remove(val);
+            stdSet.erase(val);
+        } else {
+            EXPECT_EQ(tree.contains(val), stdSet.count(val) == 1);
+        }
+    }
+    auto snap = tree.snapshot();
+    EXPECT_EQ(vector<int>(snap.begin(), snap.end()), vector<int>(stdSet.begin(), stdSet.end()));
+}
+
+TEST(PersistentTreeTest, ConcurrentReadersSeeConsistentVersions) {
+    PersistentTree<> tree;
+    atomic<bool> done(false);
+    atomic<int> badSnapshots(0);
+
+    auto reader = [&]() {
+        while (!done.load()) {
+            auto snap = tree.snapshot();
+            // The writer always inserts 2k before 2k+1, so a version that
+            // contains an odd key must contain the even key before it.
+            int prev = -1;
+            for (int key : snap) {
+                if (key <= prev) badSnapshots++;
+                if (key % 2 == 1 && !snap.contains(key - 1)) badSnapshots++;
+                prev = key;
+            }
+        }
+    };
+    thread r1(reader), r2(reader);
+    for (int i = 0; i < 2000; ++i) {
+        tree.insert((i * 37 % 2000) * 2);
+        tree.insert((i * 37 % 2000) * 2 + 1);
+    }
+    done = true;
+    r1.join();
+    r2.join();
+    EXPECT_EQ(badSnapshots.load(), 0);
+}
+
+// 13. SKIP LIST TESTS
+
+TEST(SkipListTest, RandomStressAgainstSet) {
+    mt19937 rng(48);
+    SkipListSet skip;
+    set<string> ref;
+    for (int i = 0; i < 20000; ++i) {
+        string key = to_string(rng() % 2000);
+        int op = rng() % 3;
+        if (op == 0) {
+            EXPECT_EQ(skip.insert(key), ref.insert(key).second);
+        } else if (op == 1) {
+            EXPECT_EQ(skip.remove(key), ref.erase(key) == 1);
+        } else {
+            EXPECT_EQ(skip.contains(key), ref.count(key) == 1);
+        }
+        if (i % 5000 == 0) {
+            EXPECT_TRUE(equal(skip.begin(), skip.end(), ref.begin(), ref.end()));
+        }
+    }
+    EXPECT_EQ(skip.get_size(), ref.size());
+    EXPECT_TRUE(equal(skip.begin(), skip.end(), ref.begin(), ref.end()));
+    EXPECT_LE(skip.get_level_count(), 12);
+
+    vector<string> range;
+    skip.for_range("3", "4", [&](const string& key) { range.push_back(key); });
+    EXPECT_TRUE(equal(range.begin(), range.end(), ref.lower_bound("3"), ref.lower_bound("4")));
+    EXPECT_EQ(*skip.lower_bound("1995"), *ref.lower_bound("1995"));
+    EXPECT_TRUE(skip.lower_bound("A") == skip.end());
+
+    skip.clear();
+    EXPECT_TRUE(skip.isEmpty());
+    EXPECT_TRUE(skip.begin() == skip.end());
+    EXPECT_TRUE(skip.insert("x"));
+    EXPECT_TRUE(skip.contains("x"));
+}
+
+TEST(SkipListTest, PooledFromMemoryResource) {
+    CountingResource counting;
+    {
+        SkipListSet skip(NodeAllocator::pool(&counting));
+        for (int i = 0; i < 5000; ++i) skip.insert(to_string(i));
+        EXPECT_GT(counting.outstanding, static_cast<long long>(NODE_SLAB_BYTES));
+        EXPECT_EQ(counting.outstanding % NODE_SLAB_BYTES, 0);
+        for (int i = 0; i < 5000; i += 2) skip.remove(to_string(i));
+        long long slabs = counting.outstanding;
+        // Removed towers are reused before new slabs are taken.
+        for (int i = 0; i < 5000; i += 2) skip.insert(to_string(i));
+        EXPECT_LE(counting.outstanding, slabs + static_cast<long long>(NODE_SLAB_BYTES));
+        EXPECT_EQ(skip.get_size(), 5000u);
+    }
+    EXPECT_EQ(counting.outstanding, 0);
+}
+
+TEST(SkipListTest, ConcurrentInsertRemoveContains) {
+    ConcurrentSkipListSet skip;
+    const int threads = 4;
+    const int perThread = 3000;
+    atomic<int> inserted(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            // Ranges overlap by half, so every key is raced by two threads.
+            for (int i = 0; i < perThread; ++i) {
+                if (skip.insert(to_string(t * perThread / 2 + i))) inserted++;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    int distinct = (threads + 1) * perThread / 2;
+    EXPECT_EQ(inserted.load(), distinct);
+    EXPECT_EQ(skip.get_size(), static_cast<size_t>(distinct));
+
+    set<string> ref;
+    for (int i = 0; i < distinct; ++i) ref.insert(to_string(i));
+    EXPECT_TRUE(equal(skip.begin(), skip.end(), ref.begin(), ref.end()));
+
+    workers.clear();
+    atomic<int> removed(0);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < distinct; i += 2) {
+                if (skip.remove(to_string(i))) removed++;
+                if (!skip.contains(to_string(i + 1))) removed += 1000000;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    EXPECT_EQ(removed.load(), (distinct + 1) / 2);
+    EXPECT_FALSE(skip.contains("0"));
+    EXPECT_TRUE(skip.contains("1"));
+    EXPECT_EQ(*skip.begin(), "1");
+
+    // A removed key is revived by insert; purge unlinks the rest.
+    EXPECT_TRUE(skip.insert("0"));
+    EXPECT_FALSE(skip.insert("0"));
+    skip.purge();
+    size_t count = 0;
+    string prev;
+    for (const string& key : skip) {
+        if (count > 0) {
+            EXPECT_LT(prev, key);
+        }
+        prev = key;
+        count++;
+    }
+    EXPECT_EQ(count, skip.get_size());
+    EXPECT_EQ(count, static_cast<size_t>(distinct / 2 + 1));
+    vector<string> range;
+    skip.for_range("10", "12", [&](const string& key) { range.push_back(key); });
+    EXPECT_EQ(range.front(), "1001");
+    EXPECT_TRUE(skip.insert("2"));
+    EXPECT_TRUE(skip.contains("2"));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();